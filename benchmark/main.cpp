@@ -0,0 +1,547 @@
+// Headless benchmark of the voxel core: chunk generation, neighbourhood linking, voxel
+// neighbour queries and CPU meshing.
+//
+// Usage: VoxelBenchmark [--sizes 4,8x2x8] [--threads 1,4] [--iterations 5] [--mode naive|greedy|both] [--lod 0..3]
+//                       [--chunk 16x16x16,32x32x32,16x256x16] [--layout linear|morton|both]
+//                       [--generator noise|sphere] [--seed N] [--noise scalar|sse41|avx2] [--format json|csv] [--verify]
+//
+// World sizes are in chunks of the configuration being run; compare configurations by
+// the voxel rates.
+//
+// --verify checks the mesher instead of timing it, for every world size, configuration
+// and mode: full resolution meshes must show exactly the faces a voxel by
+// voxel reference finds, and random mixes of levels of detail must leave no cracks
+// between neighbouring chunks. Exits with failure if either check fails.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include <Voxel/Chunk.hpp>
+#include <Voxel/ChunkGrid.hpp>
+#include <Voxel/ChunkMap.hpp>
+#include <Voxel/NoiseTerrainGenerator.hpp>
+#include <Render/VoxelMesher.hpp>
+#include <common/Noise.hpp>
+#include <common/ThreadPool.hpp>
+
+
+template <typename ChunkT>
+static constexpr glm::ivec3 chunk_dims() { return { int(ChunkT::CHUNK_X), int(ChunkT::CHUNK_Y), int(ChunkT::CHUNK_Z) }; }
+
+struct Options
+{
+	std::vector<glm::ivec3> sizes{ { 4, 4, 4 }, { 8, 8, 8 }, { 16, 4, 16 } };
+	std::vector<std::size_t> threads; // defaults to 1 and the hardware thread count
+	std::vector<VoxelMesher::EMode> modes{ VoxelMesher::EMode::Naive, VoxelMesher::EMode::Greedy };
+	int lod = 0; // level of detail meshed, see VoxelMesher::build_mesh_data
+	std::vector<glm::ivec3> chunk_sizes{ chunk_dims<Chunk>() };
+	std::vector<EChunkLayout> layouts{ EChunkLayout::Linear, EChunkLayout::Morton };
+	int iterations = 5;
+	bool sphere_generator = false;
+	std::uint32_t seed = 1337;
+	bool csv = false;
+	bool verify = false;
+};
+
+struct Result
+{
+	glm::ivec3 chunk_size;
+	EChunkLayout layout;
+	glm::ivec3 size;
+	std::size_t threads;
+	VoxelMesher::EMode mode;
+	int lod;
+	std::size_t chunks = 0;
+	std::size_t voxels = 0;
+	std::size_t vertices = 0;
+	std::size_t solid_neighbours = 0; // keeps the query phase from being optimised out
+	double generate_seconds = 0.0;
+	double link_seconds = 0.0;
+	double query_seconds = 0.0;
+	double mesh_seconds = 0.0;
+};
+
+
+static std::vector<std::string> split(const std::string& value, char separator)
+{
+	std::vector<std::string> parts;
+	std::stringstream stream(value);
+	for (std::string part; std::getline(stream, part, separator);)
+		if (!part.empty()) parts.push_back(part);
+	return parts;
+}
+
+// "8" is 8x8x8, "8x2x8" is explicit.
+static glm::ivec3 parse_size(const std::string& value)
+{
+	const auto axes = split(value, 'x');
+	if (axes.size() == 1) return glm::ivec3(std::stoi(axes[0]));
+	if (axes.size() == 3) return { std::stoi(axes[0]), std::stoi(axes[1]), std::stoi(axes[2]) };
+	throw std::invalid_argument("bad world size '" + value + "'");
+}
+
+static Options parse_options(int argc, char** argv)
+{
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		const std::string arg = argv[i];
+		if (arg == "--verify") {
+			options.verify = true;
+			continue;
+		}
+		if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+		const std::string value = argv[++i];
+
+		if (arg == "--sizes") {
+			options.sizes.clear();
+			for (const auto& size : split(value, ',')) options.sizes.push_back(parse_size(size));
+		}
+		else if (arg == "--threads") {
+			options.threads.clear();
+			for (const auto& count : split(value, ',')) options.threads.push_back(std::max(1, std::stoi(count)));
+		}
+		else if (arg == "--chunk") {
+			options.chunk_sizes.clear();
+			for (const auto& size : split(value, ',')) options.chunk_sizes.push_back(parse_size(size));
+		}
+		else if (arg == "--layout") {
+			if (value == "linear") options.layouts = { EChunkLayout::Linear };
+			else if (value == "morton") options.layouts = { EChunkLayout::Morton };
+			else if (value != "both") throw std::invalid_argument("bad layout '" + value + "'");
+		}
+		else if (arg == "--iterations") {
+			options.iterations = std::max(1, std::stoi(value));
+		}
+		else if (arg == "--mode") {
+			if (value == "naive") options.modes = { VoxelMesher::EMode::Naive };
+			else if (value == "greedy") options.modes = { VoxelMesher::EMode::Greedy };
+			else if (value != "both") throw std::invalid_argument("bad mode '" + value + "'");
+		}
+		else if (arg == "--lod") {
+			options.lod = std::stoi(value);
+			if (options.lod < 0 || options.lod >= CHUNK_LOD_COUNT) throw std::invalid_argument("bad lod '" + value + "'");
+		}
+		else if (arg == "--generator") {
+			if (value != "noise" && value != "sphere") throw std::invalid_argument("bad generator '" + value + "'");
+			options.sphere_generator = value == "sphere";
+		}
+		else if (arg == "--seed") {
+			options.seed = static_cast<std::uint32_t>(std::stoul(value));
+		}
+		else if (arg == "--noise") {
+			if (value == "scalar") Noise::set_backend(Noise::EBackend::Scalar);
+			else if (value == "sse41") Noise::set_backend(Noise::EBackend::SSE41);
+			else if (value == "avx2") Noise::set_backend(Noise::EBackend::AVX2);
+			else throw std::invalid_argument("bad noise backend '" + value + "'");
+		}
+		else if (arg == "--format") {
+			if (value != "json" && value != "csv") throw std::invalid_argument("bad format '" + value + "'");
+			options.csv = value == "csv";
+		}
+		else {
+			throw std::invalid_argument("unknown option " + arg);
+		}
+	}
+	return options;
+}
+
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Generate, link and mesh a block of chunks, as the streamer does without the GL upload.
+template <typename ChunkT>
+static Result run_once(const TerrainGenerator& generator, std::uint32_t seed, glm::ivec3 size, std::size_t threads, VoxelMesher::EMode mode,
+					   int lod)
+{
+	// The calling thread takes part in parallel_for, so N threads is N-1 workers.
+	std::unique_ptr<ThreadPool> pool = threads > 1 ? std::make_unique<ThreadPool>(threads - 1) : nullptr;
+	const auto parallel_for = [&](std::size_t count, const std::function<void(std::size_t)>& fn) {
+		if (pool) pool->parallel_for(count, fn);
+		else for (std::size_t i = 0; i < count; ++i) fn(i);
+	};
+
+	Result result{ chunk_dims<ChunkT>(), ChunkT::LAYOUT, size, threads, mode, lod };
+	std::vector<glm::ivec3> positions;
+	for (int y = 0; y < size.y; y++)
+		for (int z = 0; z < size.z; z++)
+			for (int x = 0; x < size.x; x++)
+				positions.push_back({ x, y, z });
+	result.chunks = positions.size();
+	result.voxels = result.chunks * ChunkT::CHUNK_VOLUME;
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::shared_ptr<ChunkT>> chunks(result.chunks);
+	parallel_for(chunks.size(), [&](std::size_t i) { chunks[i] = generator.create_chunk<ChunkT>(positions[i], seed); });
+	result.generate_seconds = seconds_since(start);
+
+	start = std::chrono::steady_clock::now();
+	BasicChunkGrid<ChunkT> grid;
+	grid.reserve(chunks.size());
+	for (std::size_t i = 0; i < chunks.size(); ++i)
+		grid.add_chunk(positions[i], chunks[i]);
+	result.link_seconds = seconds_since(start);
+
+	// Six face neighbours of every voxel, the access pattern of lighting and ambient occlusion.
+	start = std::chrono::steady_clock::now();
+	std::vector<std::size_t> solid_counts(chunks.size());
+	parallel_for(chunks.size(), [&](std::size_t i) {
+		const ChunkT& chunk = *chunks[i];
+		std::size_t solid = 0;
+		for (int z = 0; z < int(ChunkT::CHUNK_Z); z++)
+			for (int y = 0; y < int(ChunkT::CHUNK_Y); y++)
+				for (int x = 0; x < int(ChunkT::CHUNK_X); x++)
+					solid += (chunk.get_id(x - 1, y, z) != 0) + (chunk.get_id(x + 1, y, z) != 0)
+						+ (chunk.get_id(x, y - 1, z) != 0) + (chunk.get_id(x, y + 1, z) != 0)
+						+ (chunk.get_id(x, y, z - 1) != 0) + (chunk.get_id(x, y, z + 1) != 0);
+		solid_counts[i] = solid;
+	});
+	result.query_seconds = seconds_since(start);
+	result.solid_neighbours = 0;
+	for (const auto count : solid_counts) result.solid_neighbours += count;
+
+	start = std::chrono::steady_clock::now();
+	std::vector<std::size_t> vertex_counts(chunks.size());
+	parallel_for(chunks.size(), [&](std::size_t i) {
+		vertex_counts[i] = VoxelMesher::build_mesh_data(grid.get_neighbourhood(positions[i]), mode, lod).vertices.size();
+	});
+	result.mesh_seconds = seconds_since(start);
+
+	result.vertices = 0;
+	for (const auto count : vertex_counts) result.vertices += count;
+	return result;
+}
+
+// Median of each phase over the iterations, so one descheduled run does not skew the report.
+template <typename ChunkT>
+static Result run(const TerrainGenerator& generator, std::uint32_t seed, glm::ivec3 size, std::size_t threads,
+				  VoxelMesher::EMode mode, int lod, int iterations)
+{
+	std::vector<Result> runs;
+	for (int i = 0; i < iterations; i++) runs.push_back(run_once<ChunkT>(generator, seed, size, threads, mode, lod));
+
+	const auto median = [&](double Result::* field) {
+		std::vector<double> values;
+		for (const auto& r : runs) values.push_back(r.*field);
+		std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+		return values[values.size() / 2];
+	};
+
+	Result result = runs.front();
+	result.generate_seconds = median(&Result::generate_seconds);
+	result.link_seconds = median(&Result::link_seconds);
+	result.query_seconds = median(&Result::query_seconds);
+	result.mesh_seconds = median(&Result::mesh_seconds);
+	return result;
+}
+
+static const char* mode_name(VoxelMesher::EMode mode) { return mode == VoxelMesher::EMode::Greedy ? "greedy" : "naive"; }
+
+static const char* layout_name(EChunkLayout layout) { return layout == EChunkLayout::Morton ? "morton" : "linear"; }
+
+// A face of one voxel, in voxels of the mesh's level; merged quads cover several.
+struct UnitFace
+{
+	int x, y, z;
+	std::uint32_t face; // ChunkFace
+	std::uint16_t id;   // 0 where only coverage matters
+
+	auto operator<=>(const UnitFace&) const = default;
+};
+
+static constexpr glm::ivec3 FACE_NORMALS[6] = { { 0, 1, 0 }, { 0, -1, 0 }, { 1, 0, 0 }, { -1, 0, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+static int face_axis(std::uint32_t face) { return face < 2 ? 1 : (face < 4 ? 0 : 2); }
+
+// Splits every quad of the mesh into the voxel faces it covers, sorted.
+static std::vector<UnitFace> expand_faces(const ChunkMeshData& mesh, bool with_ids)
+{
+	std::vector<UnitFace> faces;
+	for (std::size_t q = 0; q + 4 <= mesh.vertices.size(); q += 4) {
+		glm::ivec3 lo(1 << 30), hi(-(1 << 30));
+		for (std::size_t k = q; k < q + 4; k++) {
+			const std::uint32_t p = mesh.vertices[k].position;
+			const glm::ivec3 corner(p & 511, (p >> 9) & 511, (p >> 18) & 511);
+			lo = glm::min(lo, corner);
+			hi = glm::max(hi, corner);
+		}
+		const std::uint32_t face = (mesh.vertices[q].position >> 27) & 7;
+		const std::uint16_t id = with_ids ? static_cast<std::uint16_t>(mesh.vertices[q].material & 0xffff) : 0;
+
+		// Faces on the positive side sit on the far corner of their voxel.
+		const int axis = face_axis(face);
+		if (face % 2 == 0) lo[axis]--;
+		hi[axis] = lo[axis] + 1;
+
+		for (int z = lo.z; z < hi.z; z++)
+			for (int y = lo.y; y < hi.y; y++)
+				for (int x = lo.x; x < hi.x; x++)
+					faces.push_back({ x, y, z, face, id });
+	}
+	std::sort(faces.begin(), faces.end());
+	return faces;
+}
+
+template <typename ChunkT>
+static bool solid_at(const BasicChunkNeighbourhood<ChunkT>& chunks, glm::ivec3 p)
+{
+	const glm::ivec3 dims = chunk_dims<ChunkT>();
+	glm::ivec3 offset;
+	for (int a = 0; a < 3; a++) offset[a] = p[a] < 0 ? -1 : (p[a] >= dims[a] ? 1 : 0);
+	const auto& chunk = chunks.get(offset.x, offset.y, offset.z);
+	const glm::ivec3 local = p - offset * dims;
+	return chunk && chunk->is_solid(local.x, local.y, local.z);
+}
+
+// Returns the number of failed checks.
+template <typename ChunkT>
+static int verify(const TerrainGenerator& generator, std::uint32_t seed, glm::ivec3 size, const std::vector<VoxelMesher::EMode>& modes)
+{
+	const glm::ivec3 dims = chunk_dims<ChunkT>();
+
+	std::vector<glm::ivec3> positions;
+	for (int y = 0; y < size.y; y++)
+		for (int z = 0; z < size.z; z++)
+			for (int x = 0; x < size.x; x++)
+				positions.push_back({ x, y, z });
+
+	BasicChunkGrid<ChunkT> grid;
+	ChunkMap<std::size_t> index;
+	for (std::size_t i = 0; i < positions.size(); i++) {
+		grid.add_chunk(positions[i], generator.create_chunk<ChunkT>(positions[i], seed));
+		index[positions[i]] = i;
+	}
+
+	// Occupancy of every chunk at every level: a coarse cell is solid if any voxel of its block is.
+	std::vector<std::array<std::vector<bool>, CHUNK_LOD_COUNT>> occupancy(positions.size());
+	for (std::size_t i = 0; i < positions.size(); i++) {
+		const ChunkT& chunk = *grid.get_chunk(positions[i]);
+		for (int lod = 0; lod < CHUNK_LOD_COUNT; lod++) {
+			const glm::ivec3 coarse = dims / (1 << lod);
+			auto& cells = occupancy[i][lod];
+			cells.assign(static_cast<std::size_t>(coarse.x * coarse.y * coarse.z), false);
+			for (int z = 0; z < dims.z; z++)
+				for (int y = 0; y < dims.y; y++)
+					for (int x = 0; x < dims.x; x++)
+						if (chunk.is_solid(x, y, z))
+							cells[(x >> lod) + coarse.x * ((y >> lod) + coarse.y * (z >> lod))] = true;
+		}
+	}
+
+	int failures = 0;
+	for (const auto mode : modes) {
+		// Every exposed voxel face exactly once, with the voxel's id.
+		std::size_t mismatched = 0;
+		for (const auto& pos : positions) {
+			const auto& chunks = grid.get_neighbourhood(pos);
+			std::vector<UnitFace> expected;
+			for (int z = 0; z < dims.z; z++)
+				for (int y = 0; y < dims.y; y++)
+					for (int x = 0; x < dims.x; x++) {
+						const std::uint16_t id = chunks.center()->get_id(x, y, z);
+						if (id == 0) continue;
+						for (std::uint32_t face = 0; face < 6; face++)
+							if (!solid_at(chunks, glm::ivec3(x, y, z) + FACE_NORMALS[face]))
+								expected.push_back({ x, y, z, face, id });
+					}
+			std::sort(expected.begin(), expected.end());
+			if (expand_faces(VoxelMesher::build_mesh_data(chunks, mode, 0), true) != expected) mismatched++;
+		}
+
+		// Coverage of every level's mesh, then random level assignments: wherever one side of a
+		// chunk border is solid at its level and the other is not, the solid side needs a face.
+		std::vector<std::array<std::vector<UnitFace>, CHUNK_LOD_COUNT>> covered(positions.size());
+		for (std::size_t i = 0; i < positions.size(); i++)
+			for (int lod = 0; lod < CHUNK_LOD_COUNT; lod++)
+				covered[i][lod] = expand_faces(VoxelMesher::build_mesh_data(grid.get_neighbourhood(positions[i]), mode, lod), false);
+
+		const auto solid = [&](std::size_t chunk, int lod, glm::ivec3 p) {
+			const glm::ivec3 coarse = dims / (1 << lod);
+			const glm::ivec3 c = p / (1 << lod);
+			return static_cast<bool>(occupancy[chunk][lod][c.x + coarse.x * (c.y + coarse.y * c.z)]);
+		};
+		const auto has_face = [&](std::size_t chunk, int lod, glm::ivec3 p, std::uint32_t face) {
+			const glm::ivec3 c = p / (1 << lod);
+			return std::binary_search(covered[chunk][lod].begin(), covered[chunk][lod].end(), UnitFace{ c.x, c.y, c.z, face, 0 });
+		};
+
+		std::mt19937 rng(seed);
+		std::vector<int> lods(positions.size());
+		std::size_t checked = 0, cracks = 0;
+		for (int trial = 0; trial < 8; trial++) {
+			for (auto& lod : lods) lod = static_cast<int>(rng() % CHUNK_LOD_COUNT);
+
+			for (std::size_t a = 0; a < positions.size(); a++)
+				for (int axis = 0; axis < 3; axis++) {
+					glm::ivec3 next = positions[a];
+					next[axis]++;
+					const std::size_t* b = index.find(next);
+					if (!b) continue;
+
+					const std::uint32_t pos_face = axis == 1 ? 0 : (axis == 0 ? 2 : 4);
+					const int u = (axis + 1) % 3, v = (axis + 2) % 3;
+					for (int j = 0; j < dims[v]; j++)
+						for (int i = 0; i < dims[u]; i++) {
+							glm::ivec3 pa, pb;
+							pa[axis] = dims[axis] - 1;
+							pb[axis] = 0;
+							pa[u] = pb[u] = i;
+							pa[v] = pb[v] = j;
+
+							const bool sa = solid(a, lods[a], pa), sb = solid(*b, lods[*b], pb);
+							checked++;
+							if (sa && !sb && !has_face(a, lods[a], pa, pos_face)) cracks++;
+							if (sb && !sa && !has_face(*b, lods[*b], pb, pos_face + 1)) cracks++;
+						}
+				}
+		}
+
+		std::printf("verify %dx%dx%d %s, %dx%dx%d chunks, %s: %zu of %zu chunks mismatch the reference faces, %zu cracks in %zu border squares\n",
+			dims.x, dims.y, dims.z, layout_name(ChunkT::LAYOUT), size.x, size.y, size.z, mode_name(mode), mismatched, positions.size(), cracks, checked);
+		failures += (mismatched > 0) + (cracks > 0);
+	}
+	return failures;
+}
+
+using RunFn = Result (*)(const TerrainGenerator&, std::uint32_t, glm::ivec3, std::size_t, VoxelMesher::EMode, int, int);
+
+using VerifyFn = int (*)(const TerrainGenerator&, std::uint32_t, glm::ivec3, const std::vector<VoxelMesher::EMode>&);
+
+// Only the configurations compiled into VoxelCore can be run.
+static RunFn find_config(glm::ivec3 chunk_size, EChunkLayout layout)
+{
+#define VOXEL_MATCH_CHUNK(x, y, z, chunk_layout) \
+	if (chunk_size == glm::ivec3(x, y, z) && layout == chunk_layout) return &run<BasicChunk<x, y, z, chunk_layout>>;
+	VOXEL_CHUNK_CONFIGS(VOXEL_MATCH_CHUNK)
+#undef VOXEL_MATCH_CHUNK
+	return nullptr;
+}
+
+static VerifyFn find_verify(glm::ivec3 chunk_size, EChunkLayout layout)
+{
+#define VOXEL_MATCH_CHUNK(x, y, z, chunk_layout) \
+	if (chunk_size == glm::ivec3(x, y, z) && layout == chunk_layout) return &verify<BasicChunk<x, y, z, chunk_layout>>;
+	VOXEL_CHUNK_CONFIGS(VOXEL_MATCH_CHUNK)
+#undef VOXEL_MATCH_CHUNK
+	return nullptr;
+}
+
+
+static double per_second(double amount, double seconds) { return seconds > 0.0 ? amount / seconds : 0.0; }
+
+static const char* backend_name(Noise::EBackend backend)
+{
+	switch (backend) {
+	case Noise::EBackend::AVX2: return "avx2";
+	case Noise::EBackend::SSE41: return "sse41";
+	default: return "scalar";
+	}
+}
+
+static void print_csv(const std::vector<Result>& results)
+{
+	std::printf("chunk_x,chunk_y,chunk_z,layout,size_x,size_y,size_z,threads,mode,lod,chunks,voxels,vertices,generate_s,link_s,query_s,mesh_s,"
+		"generate_chunks_per_s,generate_voxels_per_s,link_chunks_per_s,query_voxels_per_s,mesh_chunks_per_s,mesh_voxels_per_s,mesh_vertices_per_s\n");
+	for (const auto& r : results) {
+		std::printf("%d,%d,%d,%s,%d,%d,%d,%zu,%s,%d,%zu,%zu,%zu,%.6f,%.6f,%.6f,%.6f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+			r.chunk_size.x, r.chunk_size.y, r.chunk_size.z, layout_name(r.layout),
+			r.size.x, r.size.y, r.size.z, r.threads, mode_name(r.mode), r.lod, r.chunks, r.voxels, r.vertices,
+			r.generate_seconds, r.link_seconds, r.query_seconds, r.mesh_seconds,
+			per_second(r.chunks, r.generate_seconds), per_second(r.voxels, r.generate_seconds),
+			per_second(r.chunks, r.link_seconds), per_second(r.voxels, r.query_seconds),
+			per_second(r.chunks, r.mesh_seconds), per_second(r.voxels, r.mesh_seconds), per_second(r.vertices, r.mesh_seconds));
+	}
+}
+
+static void print_json(const std::vector<Result>& results, const Options& options)
+{
+	std::printf("{\n  \"iterations\": %d,\n  \"generator\": \"%s\",\n  \"seed\": %u,\n  \"noise_backend\": \"%s\",\n"
+		"  \"results\": [\n",
+		options.iterations, options.sphere_generator ? "sphere" : "noise", options.seed, backend_name(Noise::get_backend()));
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		const auto& r = results[i];
+		std::printf("    {\"chunk_size\": [%d, %d, %d], \"layout\": \"%s\", \"size\": [%d, %d, %d], \"threads\": %zu, \"mode\": \"%s\", \"lod\": %d, "
+			"\"chunks\": %zu, \"voxels\": %zu, \"vertices\": %zu, "
+			"\"generate\": {\"seconds\": %.6f, \"chunks_per_s\": %.1f, \"voxels_per_s\": %.1f}, "
+			"\"link\": {\"seconds\": %.6f, \"chunks_per_s\": %.1f}, "
+			"\"query\": {\"seconds\": %.6f, \"voxels_per_s\": %.1f}, "
+			"\"mesh\": {\"seconds\": %.6f, \"chunks_per_s\": %.1f, \"voxels_per_s\": %.1f, \"vertices_per_s\": %.1f}}%s\n",
+			r.chunk_size.x, r.chunk_size.y, r.chunk_size.z, layout_name(r.layout),
+			r.size.x, r.size.y, r.size.z, r.threads, mode_name(r.mode), r.lod, r.chunks, r.voxels, r.vertices,
+			r.generate_seconds, per_second(r.chunks, r.generate_seconds), per_second(r.voxels, r.generate_seconds),
+			r.link_seconds, per_second(r.chunks, r.link_seconds),
+			r.query_seconds, per_second(r.voxels, r.query_seconds),
+			r.mesh_seconds, per_second(r.chunks, r.mesh_seconds), per_second(r.voxels, r.mesh_seconds),
+			per_second(r.vertices, r.mesh_seconds),
+			i + 1 < results.size() ? "," : "");
+	}
+	std::printf("  ]\n}\n");
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	try {
+		options = parse_options(argc, argv);
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\nusage: %s [--sizes 4,8x2x8] [--threads 1,4] [--iterations N] "
+			"[--mode naive|greedy|both] [--lod 0..3] [--chunk 16x16x16,32x32x32,16x256x16] [--layout linear|morton|both] [--generator noise|sphere] [--seed N] [--noise scalar|sse41|avx2] [--format json|csv] [--verify]\n", e.what(), argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	const std::size_t hardware_threads = std::thread::hardware_concurrency();
+	if (options.threads.empty()) {
+		options.threads.push_back(1);
+		if (hardware_threads > 1) options.threads.push_back(hardware_threads);
+	}
+
+	std::vector<RunFn> configs;
+	for (const auto& chunk_size : options.chunk_sizes)
+		for (const auto layout : options.layouts) {
+			configs.push_back(find_config(chunk_size, layout));
+			if (!configs.back()) {
+				std::fprintf(stderr, "chunk size %dx%dx%d (%s) is not compiled in (see VOXEL_CHUNK_CONFIGS)\n",
+					chunk_size.x, chunk_size.y, chunk_size.z, layout_name(layout));
+				return EXIT_FAILURE;
+			}
+		}
+
+	std::unique_ptr<TerrainGenerator> generator;
+	if (options.sphere_generator) generator = std::make_unique<SphereTerrainGenerator>();
+	else generator = std::make_unique<NoiseTerrainGenerator>();
+
+	if (options.verify) {
+		int failures = 0;
+		for (const auto& chunk_size : options.chunk_sizes)
+			for (const auto layout : options.layouts)
+				for (const auto& size : options.sizes)
+					failures += find_verify(chunk_size, layout)(*generator, options.seed, size, options.modes);
+		return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+
+	std::vector<Result> results;
+	for (const auto config : configs)
+		for (const auto& size : options.sizes)
+			for (const auto threads : options.threads)
+				for (const auto mode : options.modes)
+					results.push_back(config(*generator, options.seed, size, threads, mode, options.lod, options.iterations));
+
+	if (options.csv) print_csv(results);
+	else print_json(results, options);
+	return EXIT_SUCCESS;
+}
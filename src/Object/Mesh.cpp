@@ -13,8 +13,24 @@ Mesh::Mesh(std::shared_ptr<VertexBuffer> vertex_buffer, std::size_t vertex_count
 	m_VAO.add_vertex_buffer(*m_vertex_buffer);
 }
 
+Mesh::Mesh(std::shared_ptr<VertexBuffer> vertex_buffer, std::size_t vertex_count,
+           std::shared_ptr<IndexBuffer> index_buffer, std::size_t index_count)
+    : m_vertex_buffer(vertex_buffer),
+      m_vertex_count(vertex_count),
+      m_index_buffer(index_buffer),
+      m_index_count(index_count)
+{
+    m_VAO.bind();
+    m_VAO.add_vertex_buffer(*m_vertex_buffer);
+    m_VAO.set_index_buffer(*m_index_buffer);
+}
+
 void Mesh::draw(unsigned int primitive) const
 {
     m_VAO.bind();
-    glDrawArrays(primitive, 0, static_cast<GLsizei>(m_vertex_count));
+
+    if (m_index_buffer)
+        glDrawElements(primitive, static_cast<GLsizei>(m_index_count), m_index_buffer->get_gl_type(), nullptr);
+    else
+        glDrawArrays(primitive, 0, static_cast<GLsizei>(m_vertex_count));
 }
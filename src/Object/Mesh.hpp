@@ -10,6 +10,8 @@ class Mesh
 {
 public:
     Mesh(std::shared_ptr<VertexBuffer> vertex_buffer, std::size_t vertex_count);
+    Mesh(std::shared_ptr<VertexBuffer> vertex_buffer, std::size_t vertex_count,
+         std::shared_ptr<IndexBuffer> index_buffer, std::size_t index_count);
 
     ~Mesh() = default;
 
@@ -17,6 +19,8 @@ public:
 
 public:
     int m_vertex_count;
+    int m_index_count = 0;
 	VertexArray m_VAO;
     std::shared_ptr<VertexBuffer> m_vertex_buffer;
+    std::shared_ptr<IndexBuffer> m_index_buffer;
 };
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "Buffer.hpp"
+
+#include <algorithm>
+
+#include <glad/gl.h>
+
+
+    static constexpr GLenum usage_to_GLenum(const VertexBuffer::EUsage usage)
+    {
+        switch (usage)
+        {
+            case VertexBuffer::EUsage::Static:  return GL_STATIC_DRAW;
+            case VertexBuffer::EUsage::Dynamic: return GL_DYNAMIC_DRAW;
+            case VertexBuffer::EUsage::Stream:  return GL_STREAM_DRAW;
+            case VertexBuffer::EUsage::Immutable: return GL_STATIC_DRAW;
+        }
+        return GL_STREAM_DRAW;
+    }
+
+
+    Buffer::Buffer(const size_t size, const void* data, const VertexBuffer::EUsage usage)
+        : m_size(size)
+        , m_usage(usage)
+    {
+        glCreateBuffers(1, &m_id);
+        glNamedBufferData(m_id, static_cast<GLsizeiptr>(m_size), data, usage_to_GLenum(m_usage));
+    }
+
+
+    Buffer::~Buffer()
+    {
+        glDeleteBuffers(1, &m_id);
+    }
+
+
+    Buffer& Buffer::operator=(Buffer&& buffer) noexcept
+    {
+        glDeleteBuffers(1, &m_id);
+        m_id = buffer.m_id;
+        m_size = buffer.m_size;
+        m_usage = buffer.m_usage;
+        buffer.m_id = 0;
+        buffer.m_size = 0;
+        return *this;
+    }
+
+
+    Buffer::Buffer(Buffer&& buffer) noexcept
+        : m_id(buffer.m_id)
+        , m_size(buffer.m_size)
+        , m_usage(buffer.m_usage)
+    {
+        buffer.m_id = 0;
+        buffer.m_size = 0;
+    }
+
+
+    void Buffer::set_data(const void* data, const size_t size)
+    {
+        m_size = std::max(m_size, size);
+        glNamedBufferData(m_id, static_cast<GLsizeiptr>(m_size), nullptr, usage_to_GLenum(m_usage));
+        if (size > 0)
+            glNamedBufferSubData(m_id, 0, static_cast<GLsizeiptr>(size), data);
+    }
+
+
+    void Buffer::set_sub_data(const size_t offset, const void* data, const size_t size)
+    {
+        glNamedBufferSubData(m_id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+    }
+
+
+    void Buffer::bind(const unsigned int target) const
+    {
+        glBindBuffer(target, m_id);
+    }
+
+
+    void Buffer::bind_base(const unsigned int target, const unsigned int index) const
+    {
+        glBindBufferBase(target, index, m_id);
+    }
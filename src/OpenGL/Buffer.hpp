@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+#include "VertexBuffer.hpp"
+
+
+    // Untyped buffer object for data that is not a vertex or index stream, such as
+    // shader storage, uniform and indirect draw buffers. Bound to a target when used.
+    class Buffer {
+    public:
+        explicit Buffer(const size_t size, const void* data = nullptr, const VertexBuffer::EUsage usage = VertexBuffer::EUsage::Dynamic);
+        ~Buffer();
+
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+        Buffer& operator=(Buffer&& buffer) noexcept;
+        Buffer(Buffer&& buffer) noexcept;
+
+        // Replaces the whole contents. The old storage is orphaned, so draws still
+        // reading it do not stall the upload; it only grows, never shrinks.
+        void set_data(const void* data, const size_t size);
+        void set_sub_data(const size_t offset, const void* data, const size_t size);
+
+        void bind(const unsigned int target) const;
+        void bind_base(const unsigned int target, const unsigned int index) const;
+
+        unsigned int get_handle() const { return m_id; }
+        size_t get_size() const { return m_size; }
+
+    private:
+        unsigned int m_id = 0;
+        size_t m_size = 0;
+        VertexBuffer::EUsage m_usage;
+    };
+
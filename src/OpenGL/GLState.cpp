@@ -0,0 +1,83 @@
+#include "GLState.hpp"
+
+#include <glad/gl.h>
+
+
+    void GLState::use_program(const unsigned int id)
+    {
+        if (m_program == id)
+        {
+            m_stats.skipped++;
+            return;
+        }
+        glUseProgram(id);
+        m_program = id;
+        m_stats.binds++;
+    }
+
+
+    void GLState::bind_vertex_array(const unsigned int id)
+    {
+        if (m_vertex_array == id)
+        {
+            m_stats.skipped++;
+            return;
+        }
+        glBindVertexArray(id);
+        m_vertex_array = id;
+        m_stats.binds++;
+    }
+
+
+    void GLState::bind_texture(const unsigned int unit, const unsigned int id)
+    {
+        if (unit >= TEXTURE_UNITS)
+        {
+            glBindTextureUnit(unit, id);
+            m_stats.binds++;
+            return;
+        }
+        if (m_textures[unit] == id)
+        {
+            m_stats.skipped++;
+            return;
+        }
+        glBindTextureUnit(unit, id);
+        m_textures[unit] = id;
+        m_stats.binds++;
+    }
+
+
+    void GLState::forget_program(const unsigned int id)
+    {
+        if (m_program == id) m_program = UNKNOWN;
+    }
+
+
+    void GLState::forget_vertex_array(const unsigned int id)
+    {
+        if (m_vertex_array == id) m_vertex_array = UNKNOWN;
+    }
+
+
+    void GLState::forget_texture(const unsigned int id)
+    {
+        for (auto& texture : m_textures)
+            if (texture == id) texture = UNKNOWN;
+    }
+
+
+    void GLState::invalidate()
+    {
+        m_program = UNKNOWN;
+        m_vertex_array = UNKNOWN;
+        m_textures.fill(UNKNOWN);
+    }
+
+
+    GLState::Stats GLState::take_stats()
+    {
+        const Stats stats = m_stats;
+        m_stats = {};
+        return stats;
+    }
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+
+    // Shadow of the GL bindings the engine changes most (program, VAO, 2D textures per
+    // unit). Binds that would not change anything are skipped. Anything binding these
+    // behind the cache's back must call invalidate(). Context thread only.
+    class GLState {
+    public:
+        GLState() = delete;
+
+        static constexpr unsigned int TEXTURE_UNITS = 16;
+
+        struct Stats
+        {
+            size_t binds;   // issued to GL
+            size_t skipped; // already bound
+        };
+
+        static void use_program(const unsigned int id);
+        static void bind_vertex_array(const unsigned int id);
+        static void bind_texture(const unsigned int unit, const unsigned int id);
+
+        // Called before the object is deleted; GL may rebind 0 or reuse the name.
+        static void forget_program(const unsigned int id);
+        static void forget_vertex_array(const unsigned int id);
+        static void forget_texture(const unsigned int id);
+
+        // Forgets every binding, e.g. at the start of a frame after other code used GL directly.
+        static void invalidate();
+
+        // Counters since the last call, which resets them.
+        static Stats take_stats();
+
+    private:
+        static constexpr unsigned int UNKNOWN = ~0u;
+
+        static inline unsigned int m_program = UNKNOWN;
+        static inline unsigned int m_vertex_array = UNKNOWN;
+        static inline std::array<unsigned int, TEXTURE_UNITS> m_textures = [] {
+            std::array<unsigned int, TEXTURE_UNITS> textures;
+            textures.fill(UNKNOWN);
+            return textures;
+        }();
+        static inline Stats m_stats{};
+    };
+
@@ -9,16 +9,23 @@
             case VertexBuffer::EUsage::Static:  return GL_STATIC_DRAW;
             case VertexBuffer::EUsage::Dynamic: return GL_DYNAMIC_DRAW;
             case VertexBuffer::EUsage::Stream:  return GL_STREAM_DRAW;
+            case VertexBuffer::EUsage::Immutable: return GL_STATIC_DRAW;
         }
         return GL_STREAM_DRAW;
     }
 
-    IndexBuffer::IndexBuffer(const void* data, const size_t count, const VertexBuffer::EUsage usage)
+    constexpr size_t index_size(const IndexBuffer::EType type)
+    {
+        return type == IndexBuffer::EType::UInt16 ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+    }
+
+    IndexBuffer::IndexBuffer(const void* data, const size_t count, const EType type, const VertexBuffer::EUsage usage)
         : m_count(count)
+        , m_type(type)
     {
         glGenBuffers(1, &m_id);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_count * sizeof(std::uint32_t), data, usage_to_GLenum(usage));
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_count * index_size(m_type), data, usage_to_GLenum(usage));
     }
 
 
@@ -32,6 +39,7 @@
     {
         m_id = index_buffer.m_id;
         m_count = index_buffer.m_count;
+        m_type = index_buffer.m_type;
         index_buffer.m_id = 0;
         index_buffer.m_count = 0;
         return *this;
@@ -41,6 +49,7 @@
     IndexBuffer::IndexBuffer(IndexBuffer&& index_buffer) noexcept
         : m_id(index_buffer.m_id)
         , m_count(index_buffer.m_count)
+        , m_type(index_buffer.m_type)
     {
         index_buffer.m_id = 0;
         index_buffer.m_count = 0;
@@ -57,3 +66,9 @@
     {
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
+
+
+    unsigned int IndexBuffer::get_gl_type() const
+    {
+        return m_type == EType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
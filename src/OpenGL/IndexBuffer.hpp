@@ -5,7 +5,13 @@
     class IndexBuffer {
     public:
 
-        IndexBuffer(const void* data, const size_t count, const VertexBuffer::EUsage usage = VertexBuffer::EUsage::Static);
+        enum class EType
+        {
+            UInt16,
+            UInt32
+        };
+
+        IndexBuffer(const void* data, const size_t count, const EType type = EType::UInt32, const VertexBuffer::EUsage usage = VertexBuffer::EUsage::Static);
         ~IndexBuffer();
 
         IndexBuffer(const IndexBuffer&) = delete;
@@ -16,9 +22,12 @@
         void bind() const;
         static void unbind();
         size_t get_count() const { return m_count; }
+        EType get_type() const { return m_type; }
+        unsigned int get_gl_type() const;
 
     private:
         unsigned int m_id = 0;
         size_t m_count;
+        EType m_type;
     };
 
@@ -1,5 +1,6 @@
 #include "ShaderProgram.hpp"
 
+#include "GLState.hpp"
 #include "common/Log.hpp"
 
 #include <glad/gl.h>
@@ -66,6 +67,7 @@ ShaderProgram::ShaderProgram(const char* vertex_shader_src, const char* fragment
     else
     {
         m_is_compiled = true;
+        reflect();
     }
 
     glDetachShader(m_id, vertex_shader_id);
@@ -76,25 +78,30 @@ ShaderProgram::ShaderProgram(const char* vertex_shader_src, const char* fragment
 
 ShaderProgram::~ShaderProgram()
 {
+    GLState::forget_program(m_id);
     glDeleteProgram(m_id);
 }
 
 void ShaderProgram::bind() const
 {
-    glUseProgram(m_id);
+    GLState::use_program(m_id);
 }
 
 void ShaderProgram::unbind()
 {
-    glUseProgram(0);
+    GLState::use_program(0);
 }
 
 ShaderProgram& ShaderProgram::operator=(ShaderProgram&& shader_program)
 {
+    GLState::forget_program(m_id);
     glDeleteProgram(m_id);
     m_id = shader_program.m_id;
     m_is_compiled = shader_program.m_is_compiled;
 
+    m_uniforms = std::move(shader_program.m_uniforms);
+    m_uniform_blocks = std::move(shader_program.m_uniform_blocks);
+
     shader_program.m_id = 0;
     shader_program.m_is_compiled = false;
     return *this;
@@ -103,32 +110,73 @@ ShaderProgram& ShaderProgram::operator=(ShaderProgram&& shader_program)
 ShaderProgram::ShaderProgram(ShaderProgram&& shader_program)
     : m_id(shader_program.m_id)
     , m_is_compiled(shader_program.m_is_compiled)
+    , m_uniforms(std::move(shader_program.m_uniforms))
+    , m_uniform_blocks(std::move(shader_program.m_uniform_blocks))
 {
     shader_program.m_id = 0;
     shader_program.m_is_compiled = false;
 }
 
-void ShaderProgram::set_matrix4(const char* name, const glm::mat4& matrix) const
+void ShaderProgram::reflect()
+{
+    GLchar name[256];
+
+    GLint uniform_count = 0;
+    glGetProgramInterfaceiv(m_id, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniform_count);
+    for (GLint i = 0; i < uniform_count; ++i)
+    {
+        const GLenum property = GL_LOCATION;
+        GLint location = -1;
+        glGetProgramResourceiv(m_id, GL_UNIFORM, i, 1, &property, 1, nullptr, &location);
+        if (location < 0) continue; // member of a block
+
+        glGetProgramResourceName(m_id, GL_UNIFORM, i, sizeof(name), nullptr, name);
+        std::string uniform = name;
+        // Arrays are reported as "name[0]"; both spellings find the first element.
+        if (uniform.ends_with("[0]"))
+            m_uniforms.emplace(uniform.substr(0, uniform.size() - 3), location);
+        m_uniforms.emplace(std::move(uniform), location);
+    }
+
+    GLint block_count = 0;
+    glGetProgramInterfaceiv(m_id, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &block_count);
+    for (GLint i = 0; i < block_count; ++i)
+    {
+        glGetProgramResourceName(m_id, GL_UNIFORM_BLOCK, i, sizeof(name), nullptr, name);
+        m_uniform_blocks.emplace(name, static_cast<unsigned int>(i));
+    }
+
+    if (const auto it = m_uniform_blocks.find(FRAME_UNIFORMS_BLOCK); it != m_uniform_blocks.end())
+        glUniformBlockBinding(m_id, it->second, FRAME_UNIFORMS_BINDING);
+}
+
+int ShaderProgram::get_uniform(const char* name) const
+{
+    const auto it = m_uniforms.find(name);
+    return it != m_uniforms.end() ? it->second : -1;
+}
+
+void ShaderProgram::set_matrix4(const int location, const glm::mat4& matrix) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(m_id, name), 1, GL_FALSE, glm::value_ptr(matrix));
+    glProgramUniformMatrix4fv(m_id, location, 1, GL_FALSE, glm::value_ptr(matrix));
 }
 
-void ShaderProgram::set_matrix3(const char* name, const glm::mat3& matrix) const
+void ShaderProgram::set_matrix3(const int location, const glm::mat3& matrix) const
 {
-    glUniformMatrix3fv(glGetUniformLocation(m_id, name), 1, GL_FALSE, glm::value_ptr(matrix));
+    glProgramUniformMatrix3fv(m_id, location, 1, GL_FALSE, glm::value_ptr(matrix));
 }
 
-void ShaderProgram::set_int(const char* name, const int value) const
+void ShaderProgram::set_int(const int location, const int value) const
 {
-    glUniform1i(glGetUniformLocation(m_id, name), value);
+    glProgramUniform1i(m_id, location, value);
 }
 
-void ShaderProgram::set_float(const char* name, const float value) const
+void ShaderProgram::set_float(const int location, const float value) const
 {
-    glUniform1f(glGetUniformLocation(m_id, name), value);
+    glProgramUniform1f(m_id, location, value);
 }
 
-void ShaderProgram::set_vec3(const char* name, const glm::vec3& value) const
+void ShaderProgram::set_vec3(const int location, const glm::vec3& value) const
 {
-    glUniform3f(glGetUniformLocation(m_id, name), value.x, value.y, value.z);
+    glProgramUniform3f(m_id, location, value.x, value.y, value.z);
 }
@@ -1,11 +1,22 @@
 #pragma once
 
+#include <string>
+#include <unordered_map>
+
 #include <glm/mat4x4.hpp>
 
 
+    // Uniform locations and blocks are reflected once after linking. The name based
+    // setters look them up in that table; hot paths should get_uniform() once and use
+    // the location overloads. Setters write through glProgramUniform*, binding is not needed.
     class ShaderProgram
     {
     public:
+        // Block every program may declare for per-frame data (see Render/FrameUniforms.hpp);
+        // it is attached to this uniform buffer binding at link time.
+        static constexpr const char* FRAME_UNIFORMS_BLOCK = "FrameUniforms";
+        static constexpr unsigned int FRAME_UNIFORMS_BINDING = 0;
+
         ShaderProgram(const char* vertex_shader_src, const char* fragment_shader_src);
         ShaderProgram(ShaderProgram&& shader_program);
         ShaderProgram& operator=(ShaderProgram&& shader_program);
@@ -18,14 +29,29 @@
         void bind() const;
         static void unbind();
         bool is_compiled() const { return m_is_compiled; }
-        void set_matrix4(const char* name, const glm::mat4& matrix) const;
-        void set_matrix3(const char* name, const glm::mat3& matrix) const;
-        void set_int(const char* name, const int value) const;
-        void set_float(const char* name, const float value) const;
-        void set_vec3(const char* name, const glm::vec3& value) const;
+
+        // Location of an active uniform outside blocks, -1 if there is none (setters ignore -1).
+        int get_uniform(const char* name) const;
+        bool has_uniform_block(const char* name) const { return m_uniform_blocks.contains(name); }
+
+        void set_matrix4(const char* name, const glm::mat4& matrix) const { set_matrix4(get_uniform(name), matrix); }
+        void set_matrix3(const char* name, const glm::mat3& matrix) const { set_matrix3(get_uniform(name), matrix); }
+        void set_int(const char* name, const int value) const { set_int(get_uniform(name), value); }
+        void set_float(const char* name, const float value) const { set_float(get_uniform(name), value); }
+        void set_vec3(const char* name, const glm::vec3& value) const { set_vec3(get_uniform(name), value); }
+
+        void set_matrix4(const int location, const glm::mat4& matrix) const;
+        void set_matrix3(const int location, const glm::mat3& matrix) const;
+        void set_int(const int location, const int value) const;
+        void set_float(const int location, const float value) const;
+        void set_vec3(const int location, const glm::vec3& value) const;
 
     private:
+        void reflect();
+
         unsigned int m_id = 0;
         bool m_is_compiled = false;
+        std::unordered_map<std::string, int> m_uniforms;                // name -> location
+        std::unordered_map<std::string, unsigned int> m_uniform_blocks; // name -> block index
     };
 
@@ -0,0 +1,89 @@
+#include "StreamBuffer.hpp"
+
+#include "common/Log.hpp"
+
+#include <glad/gl.h>
+
+
+    static constexpr GLbitfield STREAM_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+
+    StreamBuffer::StreamBuffer(const size_t frame_size)
+        : m_frame_size(frame_size)
+    {
+        const auto size = static_cast<GLsizeiptr>(m_frame_size * FRAMES);
+
+        glCreateBuffers(1, &m_id);
+        glNamedBufferStorage(m_id, size, nullptr, STREAM_FLAGS);
+        m_mapped = static_cast<unsigned char*>(glMapNamedBufferRange(m_id, 0, size, STREAM_FLAGS));
+
+        if (!m_mapped)
+        {
+            LOG_ERROR("StreamBuffer: can't map {} bytes", size);
+            m_frame_size = 0; // every allocation fails, callers fall back to regular uploads
+        }
+    }
+
+
+    StreamBuffer::~StreamBuffer()
+    {
+        for (void* fence : m_fences)
+            if (fence) glDeleteSync(static_cast<GLsync>(fence));
+
+        if (m_mapped) glUnmapNamedBuffer(m_id);
+        glDeleteBuffers(1, &m_id);
+    }
+
+
+    void* StreamBuffer::allocate(const size_t size, const size_t alignment, size_t& offset)
+    {
+        const size_t start = (m_used + alignment - 1) / alignment * alignment;
+        if (start + size > m_frame_size)
+        {
+            m_missed += size;
+            return nullptr;
+        }
+
+        m_used = start + size;
+        offset = m_frame * m_frame_size + start;
+        return m_mapped + offset;
+    }
+
+
+    void StreamBuffer::next_frame()
+    {
+        m_fences[m_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        m_stats.used = m_used;
+        m_stats.missed = m_missed;
+        m_used = 0;
+        m_missed = 0;
+        m_frame = (m_frame + 1) % FRAMES;
+
+        auto fence = static_cast<GLsync>(m_fences[m_frame]);
+        if (!fence) return;
+
+        // Normally signalled long ago; FRAMES - 1 frames of latency are allowed.
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED)
+        {
+            m_stats.waits++;
+            do status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+            while (status == GL_TIMEOUT_EXPIRED);
+        }
+
+        glDeleteSync(fence);
+        m_fences[m_frame] = nullptr;
+    }
+
+
+    void StreamBuffer::bind(const unsigned int target) const
+    {
+        glBindBuffer(target, m_id);
+    }
+
+
+    void StreamBuffer::bind_range(const unsigned int target, const unsigned int index, const size_t offset, const size_t size) const
+    {
+        glBindBufferRange(target, index, m_id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+    }
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+
+    // Persistently mapped buffer for data the CPU writes once and the GPU reads soon after
+    // (uploads, per-frame draw data). Split into FRAMES slots used round robin; a slot is
+    // written again only once the fence placed after its frame has signalled, so writes
+    // are a plain memcpy and never wait on the driver.
+    class StreamBuffer {
+    public:
+        static constexpr unsigned int FRAMES = 3;
+
+        struct Stats
+        {
+            size_t used = 0;    // bytes of the last finished frame
+            size_t missed = 0;  // bytes that did not fit in the last finished frame
+            size_t waits = 0;   // times the CPU had to wait for the GPU, total
+        };
+
+        explicit StreamBuffer(const size_t frame_size);
+        ~StreamBuffer();
+
+        StreamBuffer(const StreamBuffer&) = delete;
+        StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+        // Space for size bytes in the current frame's slot, or nullptr when the slot is full.
+        // offset receives the position in the buffer, for copies and binds.
+        void* allocate(const size_t size, const size_t alignment, size_t& offset);
+
+        // Fences the current slot and moves on to the next one, waiting for the GPU if it
+        // still reads it. Call once per frame after the last draw using the buffer.
+        void next_frame();
+
+        void bind(const unsigned int target) const;
+        void bind_range(const unsigned int target, const unsigned int index, const size_t offset, const size_t size) const;
+
+        unsigned int get_handle() const { return m_id; }
+        const Stats& get_stats() const { return m_stats; }
+
+    private:
+        unsigned int m_id = 0;
+        unsigned char* m_mapped = nullptr;
+        size_t m_frame_size;
+        unsigned int m_frame = 0;
+        size_t m_used = 0;   // in the current slot
+        size_t m_missed = 0;
+        std::array<void*, FRAMES> m_fences{}; // GLsync of each slot's last frame
+        Stats m_stats;
+    };
+
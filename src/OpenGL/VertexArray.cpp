@@ -1,5 +1,6 @@
 ﻿#include "VertexArray.hpp"
 
+#include "GLState.hpp"
 #include "common/Log.hpp"
 
 #include <glad/gl.h>
@@ -13,6 +14,7 @@
 
     VertexArray::~VertexArray()
     {
+        GLState::forget_vertex_array(m_id);
         glDeleteVertexArrays(1, &m_id);
     }
 
@@ -41,13 +43,13 @@
 
     void VertexArray::bind() const
     {
-        glBindVertexArray(m_id);
+        GLState::bind_vertex_array(m_id);
     }
 
 
     void VertexArray::unbind()
     {
-        glBindVertexArray(0);
+        GLState::bind_vertex_array(0);
     }
 
     void VertexArray::add_vertex_buffer(const VertexBuffer& vertex_buffer)
@@ -63,11 +65,21 @@
                                current_element.offset,
                                static_cast<std::uint32_t>(vertex_buffer.get_layout().get_stride()));
 
-            glVertexAttribFormat(m_elements_count,
-                                 static_cast<GLint>(current_element.components_count),
-                                 current_element.component_type,
-                                 GL_FALSE,
-                                 0);
+            if (current_element.is_integer)
+            {
+                glVertexAttribIFormat(m_elements_count,
+                                      static_cast<GLint>(current_element.components_count),
+                                      current_element.component_type,
+                                      0);
+            }
+            else
+            {
+                glVertexAttribFormat(m_elements_count,
+                                     static_cast<GLint>(current_element.components_count),
+                                     current_element.component_type,
+                                     GL_FALSE,
+                                     0);
+            }
 
             glVertexAttribBinding(m_elements_count, m_elements_count);
 
@@ -75,6 +87,19 @@
         }
     }
 
+    void VertexArray::set_vertex_buffer(const VertexBuffer& vertex_buffer)
+    {
+        GLuint binding = 0;
+        for (const BufferElement& current_element : vertex_buffer.get_layout().get_elements())
+        {
+            glVertexArrayVertexBuffer(m_id,
+                                      binding++,
+                                      vertex_buffer.get_handle(),
+                                      current_element.offset,
+                                      static_cast<GLsizei>(vertex_buffer.get_layout().get_stride()));
+        }
+    }
+
     void VertexArray::set_index_buffer(const IndexBuffer& index_buffer)
     {
         bind();
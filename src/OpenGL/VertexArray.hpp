@@ -14,6 +14,8 @@
         VertexArray(VertexArray&& vertex_buffer) noexcept;
 
         void add_vertex_buffer(const VertexBuffer& vertex_buffer);
+        // Points the attributes of the first added buffer at another one with the same layout.
+        void set_vertex_buffer(const VertexBuffer& vertex_buffer);
         void set_index_buffer(const IndexBuffer& index_buffer);
         void bind() const;
         static void unbind();
@@ -12,18 +12,22 @@
         {
             case ShaderDataType::Float:
             case ShaderDataType::Int:
+            case ShaderDataType::UInt:
                 return 1;
 
             case ShaderDataType::Float2:
             case ShaderDataType::Int2:
+            case ShaderDataType::UInt2:
                 return 2;
 
             case ShaderDataType::Float3:
             case ShaderDataType::Int3:
+            case ShaderDataType::UInt3:
                 return 3;
 
             case ShaderDataType::Float4:
             case ShaderDataType::Int4:
+            case ShaderDataType::UInt4:
                 return 4;
         }
 
@@ -47,6 +51,12 @@
             case ShaderDataType::Int3:
             case ShaderDataType::Int4:
                 return sizeof(GLint) * shader_data_type_to_components_count(type);
+
+            case ShaderDataType::UInt:
+            case ShaderDataType::UInt2:
+            case ShaderDataType::UInt3:
+            case ShaderDataType::UInt4:
+                return sizeof(GLuint) * shader_data_type_to_components_count(type);
         }
 
         LOG_ERROR("shader_data_type_size: unknown ShaderDataType!");
@@ -69,6 +79,12 @@
             case ShaderDataType::Int3:
             case ShaderDataType::Int4:
                 return GL_INT;
+
+            case ShaderDataType::UInt:
+            case ShaderDataType::UInt2:
+            case ShaderDataType::UInt3:
+            case ShaderDataType::UInt4:
+                return GL_UNSIGNED_INT;
         }
 
         LOG_ERROR("shader_data_type_to_component_type: unknown ShaderDataType!");
@@ -83,6 +99,7 @@
             case VertexBuffer::EUsage::Static:  return GL_STATIC_DRAW;
             case VertexBuffer::EUsage::Dynamic: return GL_DYNAMIC_DRAW;
             case VertexBuffer::EUsage::Stream:  return GL_STREAM_DRAW;
+            case VertexBuffer::EUsage::Immutable: return GL_STATIC_DRAW;
         }
 
         LOG_ERROR("Unknown VertexBuffer usage");
@@ -96,6 +113,7 @@
         , components_count(shader_data_type_to_components_count(_type))
         , size(shader_data_type_size(_type))
         , offset(0)
+        , is_integer(component_type != GL_FLOAT)
     {
     }
 
@@ -105,7 +123,16 @@
     {
         glGenBuffers(1, &m_id);
         glBindBuffer(GL_ARRAY_BUFFER, m_id);
-        glBufferData(GL_ARRAY_BUFFER, size, data, usage_to_GLenum(usage));
+        if (usage == EUsage::Immutable)
+            glBufferStorage(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_STORAGE_BIT);
+        else
+            glBufferData(GL_ARRAY_BUFFER, size, data, usage_to_GLenum(usage));
+    }
+
+
+    void VertexBuffer::set_sub_data(const size_t offset, const void* data, const size_t size)
+    {
+        glNamedBufferSubData(m_id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
     }
 
 
@@ -14,6 +14,10 @@
         Int2,
         Int3,
         Int4,
+        UInt,
+        UInt2,
+        UInt3,
+        UInt4,
     };
 
     struct BufferElement
@@ -23,6 +27,7 @@
         size_t components_count;
         size_t size;
         size_t offset;
+        bool is_integer; // fed to the shader as int/uint, not converted to float
 
         BufferElement(const ShaderDataType type);
     };
@@ -59,7 +64,8 @@
         {
             Static,
             Dynamic,
-            Stream
+            Stream,
+            Immutable // fixed size storage (glBufferStorage), contents changed with set_sub_data only
         };
 
         VertexBuffer(const void* data, const size_t size, BufferLayout buffer_layout, const EUsage usage = VertexBuffer::EUsage::Static);
@@ -70,6 +76,9 @@
         VertexBuffer& operator=(VertexBuffer&& vertex_buffer) noexcept;
         VertexBuffer(VertexBuffer&& vertex_buffer) noexcept;
 
+        // Overwrites part of the buffer; the range must lie within the size it was created with.
+        void set_sub_data(const size_t offset, const void* data, const size_t size);
+
         unsigned int get_handle() const { return m_id; }
 
         const BufferLayout& get_layout() const { return m_buffer_layout; }
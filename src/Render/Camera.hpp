@@ -23,6 +23,8 @@ public:
     glm::mat4 get_projection_matrix() const { return m_projection_matrix; }
 
     glm::vec3 get_position() const{ return m_position; }
+    glm::vec3 get_direction() const { return m_direction; }
+    ProjectionMode get_projection_mode() const { return m_projection_mode; }
 
     void set_rotate_delta(const glm::vec2& delta, float dt);
 
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Face directions in the order the shader's face tables use.
+enum class ChunkFace : std::uint32_t { Top, Bottom, PosX, NegX, PosZ, NegZ };
+
+// Packed chunk vertex, decoded in main.glslv:
+//   position: corner x | y << 9 | z << 18 | face << 27 | corner id << 30
+//   material: atlas tile | light level (0..15) << 16
+// Corners sit on the voxel grid (0..CHUNK_* inclusive), UVs are derived from them per face.
+struct ChunkVertex
+{
+    std::uint32_t position;
+    std::uint32_t material;
+
+    static constexpr std::uint32_t MAX_LIGHT = 15;
+
+    static ChunkVertex pack(std::uint32_t x, std::uint32_t y, std::uint32_t z, ChunkFace face, std::uint32_t corner,
+                            std::uint32_t tile, std::uint32_t light)
+    {
+        return {
+            x | (y << 9) | (z << 18) | (static_cast<std::uint32_t>(face) << 27) | (corner << 30),
+            tile | (light << 16)
+        };
+    }
+};
+
+// Mesh resolutions of a chunk: full, then downsampled 2x, 4x and 8x (see VoxelMesher).
+inline constexpr int CHUNK_LOD_COUNT = 4;
+
+// CPU side result of meshing a chunk, ready to be uploaded on the GL thread. The
+// vertices are grouped by face direction in ChunkFace order, so each direction is a
+// range the renderer can skip when it faces away from the camera.
+struct ChunkMeshData
+{
+    std::vector<ChunkVertex> vertices;
+    std::array<std::uint32_t, 6> face_vertex_counts{}; // indexed by ChunkFace
+};
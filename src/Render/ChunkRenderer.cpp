@@ -0,0 +1,238 @@
+#include "ChunkRenderer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include <glad/gl.h>
+
+#include <Render/QuadIndexBuffer.hpp>
+
+
+static constexpr std::uint32_t PAGE_CAPACITY = 1u << 21; // vertices, 16 MiB
+static constexpr float DEFRAGMENT_THRESHOLD = 0.5f;      // share of a page's free space in holes too small to use
+static constexpr std::size_t STREAM_FRAME_SIZE = 8u << 20; // bytes per frame; larger uploads use glBufferSubData
+
+static BufferLayout chunk_layout()
+{
+	return {
+		{ ShaderDataType::UInt2 }, // packed position, material
+	};
+}
+
+
+ChunkRenderer::ChunkRenderer()
+	: m_arena(chunk_layout(), PAGE_CAPACITY),
+	  m_stream(STREAM_FRAME_SIZE),
+	  m_origins(1024 * sizeof(glm::vec4), nullptr, VertexBuffer::EUsage::Stream),
+	  m_commands(1024 * sizeof(DrawCommand), nullptr, VertexBuffer::EUsage::Stream)
+{
+	m_vao.add_vertex_buffer(m_arena.get_page(0)); // sets the vertex format; draws rebind per page
+
+	GLint alignment = 0;
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	if (alignment > 0) m_storage_alignment = static_cast<std::size_t>(alignment);
+}
+
+void ChunkRenderer::upload(glm::ivec3 pos, int lod, const ChunkMeshData& data)
+{
+	Allocation& mesh = m_meshes[pos][lod];
+	release(mesh);
+
+	mesh.resident = true;
+	mesh.vertex_count = static_cast<std::uint32_t>(data.vertices.size());
+	mesh.face_vertex_counts = data.face_vertex_counts;
+	if (mesh.vertex_count > 0) {
+		const std::size_t bytes = data.vertices.size() * sizeof(ChunkVertex);
+		std::size_t offset = 0;
+		if (void* staging = m_stream.allocate(bytes, sizeof(ChunkVertex), offset)) {
+			std::memcpy(staging, data.vertices.data(), bytes);
+			mesh.handle = m_arena.allocate(mesh.vertex_count);
+
+			const MeshArena::Location& location = m_arena.get(mesh.handle);
+			glCopyNamedBufferSubData(m_stream.get_handle(), m_arena.get_page(location.page).get_handle(),
+									 static_cast<GLintptr>(offset), static_cast<GLintptr>(location.first * sizeof(ChunkVertex)),
+									 static_cast<GLsizeiptr>(bytes));
+		}
+		else {
+			mesh.handle = m_arena.allocate(data.vertices.data(), mesh.vertex_count);
+		}
+	}
+
+	m_max_quads = std::max<std::uint32_t>(m_max_quads, mesh.vertex_count / QuadIndexBuffer::VERTICES_PER_QUAD);
+	m_vertex_count += mesh.vertex_count;
+}
+
+void ChunkRenderer::remove(glm::ivec3 pos)
+{
+	auto* meshes = m_meshes.find(pos);
+	if (!meshes) return;
+
+	for (auto& mesh : *meshes)
+		release(mesh);
+	m_meshes.erase(pos);
+}
+
+void ChunkRenderer::remove(glm::ivec3 pos, int lod)
+{
+	auto* meshes = m_meshes.find(pos);
+	if (!meshes) return;
+
+	release((*meshes)[lod]);
+	if (std::none_of(meshes->begin(), meshes->end(), [](const Allocation& mesh) { return mesh.resident; }))
+		m_meshes.erase(pos);
+}
+
+bool ChunkRenderer::contains(glm::ivec3 pos, int lod) const
+{
+	return find(pos, lod) != nullptr;
+}
+
+std::uint32_t ChunkRenderer::get_page(glm::ivec3 pos, int lod) const
+{
+	const auto* mesh = find(pos, lod);
+	return mesh && mesh->vertex_count > 0 ? m_arena.get(mesh->handle).page : 0;
+}
+
+std::uint32_t ChunkRenderer::get_vertex_count(glm::ivec3 pos, int lod) const
+{
+	const auto* mesh = find(pos, lod);
+	return mesh ? mesh->vertex_count : 0;
+}
+
+std::size_t ChunkRenderer::draw(const std::vector<DrawItem>& items, glm::ivec3 chunk_size, const Camera& camera, unsigned int primitive)
+{
+	// Without perspective every face is seen along the same direction, whatever the
+	// chunk: a face faces the camera when its normal points against the view direction.
+	const bool perspective = camera.get_projection_mode() == Camera::ProjectionMode::Perspective;
+	const glm::vec3 camera_position = camera.get_position();
+	const glm::vec3 view = camera.get_direction();
+	const bool facing[6] = { view.y <= 0.f, view.y >= 0.f, view.x <= 0.f, view.x >= 0.f, view.z <= 0.f, view.z >= 0.f };
+
+	m_page_commands.resize(m_arena.get_page_count());
+	for (auto& commands : m_page_commands)
+		commands.clear();
+	m_origin_data.clear();
+
+	for (const auto& item : items) {
+		const auto* mesh = find(item.pos, item.lod);
+		if (!mesh || mesh->vertex_count == 0) continue;
+
+		const glm::vec3 origin(item.pos * chunk_size);
+		const std::uint32_t instance = static_cast<std::uint32_t>(m_origin_data.size());
+		m_origin_data.emplace_back(origin, static_cast<float>(1 << item.lod));
+
+		// Every face of a direction lies inside the chunk, so with perspective the whole
+		// direction faces away once the camera is behind the chunk's near side on that axis.
+		// Voxel centres sit on integer coordinates, the chunk spans origin - 0.5 .. origin + chunk_size - 0.5.
+		bool visible[6];
+		if (perspective) {
+			const glm::vec3 lo = origin - 0.5f;
+			const glm::vec3 hi = origin + glm::vec3(chunk_size) - 0.5f;
+			visible[0] = camera_position.y > lo.y; // Top
+			visible[1] = camera_position.y < hi.y; // Bottom
+			visible[2] = camera_position.x > lo.x; // PosX
+			visible[3] = camera_position.x < hi.x; // NegX
+			visible[4] = camera_position.z > lo.z; // PosZ
+			visible[5] = camera_position.z < hi.z; // NegZ
+		}
+		else {
+			std::copy(std::begin(facing), std::end(facing), visible);
+		}
+
+		// Neighbouring visible directions are contiguous in the mesh and share a command.
+		const MeshArena::Location& location = m_arena.get(mesh->handle);
+		auto& commands = m_page_commands[location.page];
+		std::uint32_t first = location.first;
+		std::uint32_t run = 0;
+		for (int face = 0; face <= 6; face++) {
+			if (face < 6 && visible[face]) {
+				run += mesh->face_vertex_counts[face];
+				continue;
+			}
+			if (run > 0) {
+				commands.push_back({
+					static_cast<std::uint32_t>(run / QuadIndexBuffer::VERTICES_PER_QUAD * QuadIndexBuffer::INDICES_PER_QUAD), 1, 0,
+					static_cast<std::int32_t>(first), instance
+				});
+			}
+			if (face == 6) break;
+
+			m_vertices_skipped += mesh->face_vertex_counts[face];
+			first += run + mesh->face_vertex_counts[face];
+			run = 0;
+		}
+	}
+
+	m_command_data.clear();
+	for (const auto& commands : m_page_commands)
+		m_command_data.insert(m_command_data.end(), commands.begin(), commands.end());
+	if (m_command_data.empty()) return 0;
+
+	// Indices restart at 0 for every chunk, base_vertex moves them to its range.
+	auto index_buffer = QuadIndexBuffer::get(m_max_quads);
+	if (index_buffer != m_index_buffer) {
+		m_vao.set_index_buffer(*index_buffer);
+		m_index_buffer = std::move(index_buffer);
+	}
+
+	std::size_t offset = 0; // of the next page's commands in the indirect buffer, in bytes
+	if (!stream_draw_data(offset)) {
+		m_origins.set_data(m_origin_data.data(), m_origin_data.size() * sizeof(glm::vec4));
+		m_commands.set_data(m_command_data.data(), m_command_data.size() * sizeof(DrawCommand));
+		m_origins.bind_base(GL_SHADER_STORAGE_BUFFER, ORIGINS_BINDING);
+		m_commands.bind(GL_DRAW_INDIRECT_BUFFER);
+	}
+
+	m_vao.bind();
+	std::size_t draw_calls = 0;
+	for (std::uint32_t page = 0; page < m_page_commands.size(); page++) {
+		const std::size_t count = m_page_commands[page].size();
+		if (count == 0) continue;
+
+		m_vao.set_vertex_buffer(m_arena.get_page(page));
+		glMultiDrawElementsIndirect(primitive, m_index_buffer->get_gl_type(),
+									reinterpret_cast<const void*>(offset), static_cast<GLsizei>(count), 0);
+		offset += count * sizeof(DrawCommand);
+		draw_calls++;
+	}
+	return draw_calls;
+}
+
+bool ChunkRenderer::stream_draw_data(std::size_t& commands_offset)
+{
+	const std::size_t origins_bytes = m_origin_data.size() * sizeof(glm::vec4);
+	const std::size_t commands_bytes = m_command_data.size() * sizeof(DrawCommand);
+
+	std::size_t origins_offset = 0;
+	void* origins = m_stream.allocate(origins_bytes, m_storage_alignment, origins_offset);
+	if (!origins) return false;
+	void* commands = m_stream.allocate(commands_bytes, sizeof(std::uint32_t), commands_offset);
+	if (!commands) return false;
+
+	std::memcpy(origins, m_origin_data.data(), origins_bytes);
+	std::memcpy(commands, m_command_data.data(), commands_bytes);
+
+	m_stream.bind_range(GL_SHADER_STORAGE_BUFFER, ORIGINS_BINDING, origins_offset, origins_bytes);
+	m_stream.bind(GL_DRAW_INDIRECT_BUFFER);
+	return true;
+}
+
+bool ChunkRenderer::defragment()
+{
+	return m_arena.defragment(DEFRAGMENT_THRESHOLD);
+}
+
+void ChunkRenderer::release(Allocation& mesh)
+{
+	m_vertex_count -= mesh.vertex_count;
+	if (mesh.vertex_count > 0)
+		m_arena.release(mesh.handle);
+	mesh = {};
+}
+
+const ChunkRenderer::Allocation* ChunkRenderer::find(glm::ivec3 pos, int lod) const
+{
+	const auto* meshes = m_meshes.find(pos);
+	return meshes && (*meshes)[lod].resident ? &(*meshes)[lod] : nullptr;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <OpenGL/Buffer.hpp>
+#include <OpenGL/IndexBuffer.hpp>
+#include <OpenGL/StreamBuffer.hpp>
+#include <OpenGL/VertexArray.hpp>
+#include <OpenGL/VertexBuffer.hpp>
+
+#include <Render/Camera.hpp>
+#include <Render/ChunkMeshData.hpp>
+#include <Render/MeshArena.hpp>
+#include <Voxel/ChunkMap.hpp>
+
+
+// Keeps the meshes of every chunk in a MeshArena and draws any set of them with one
+// glMultiDrawElementsIndirect per arena page, through a single VAO. Each draw command's
+// base instance indexes the chunk origin SSBO read by main.glslv, whose w is the voxel
+// size of the mesh's level of detail. A chunk holds up to CHUNK_LOD_COUNT meshes, one
+// per level. Meshes keep their face directions apart, and the directions facing away
+// from the camera across the whole chunk are not drawn. Uploads and draw data go
+// through a persistently mapped StreamBuffer. Context thread only.
+class ChunkRenderer
+{
+public:
+	static constexpr unsigned int ORIGINS_BINDING = 0; // SSBO binding point of the chunk origins
+
+	struct DrawItem
+	{
+		glm::ivec3 pos;
+		int lod;
+	};
+
+	ChunkRenderer();
+
+	// Replaces the chunk's mesh of that level. Empty meshes are remembered but take no
+	// space. The vertices are copied once into the stream buffer and from there by the GPU.
+	void upload(glm::ivec3 pos, int lod, const ChunkMeshData& data);
+	// Frees every level of the chunk.
+	void remove(glm::ivec3 pos);
+	void remove(glm::ivec3 pos, int lod);
+	bool contains(glm::ivec3 pos, int lod) const;
+	// Arena page holding the chunk's mesh; chunks drawn together should share it.
+	std::uint32_t get_page(glm::ivec3 pos, int lod) const;
+	std::uint32_t get_vertex_count(glm::ivec3 pos, int lod) const;
+
+	// Draws the listed meshes in order, which must be resident. chunk_size scales chunk
+	// coordinates to world space; face directions the camera can't see are skipped. The
+	// caller binds the shader and its uniforms.
+	// Returns the number of draw calls (one per page used).
+	std::size_t draw(const std::vector<DrawItem>& items, glm::ivec3 chunk_size, const Camera& camera, unsigned int primitive);
+
+	// fn(glm::ivec3 pos, std::uint32_t lods) for every chunk with a mesh; bit l of lods
+	// is set when level l is resident.
+	template <typename F>
+	void for_each_mesh(F&& fn) const
+	{
+		m_meshes.for_each([&](glm::ivec3 pos, const LodMeshes& meshes) {
+			std::uint32_t lods = 0;
+			for (int lod = 0; lod < CHUNK_LOD_COUNT; lod++)
+				if (meshes[lod].resident) lods |= 1u << lod;
+			fn(pos, lods);
+		});
+	}
+
+	// Fences the stream buffer slot used since the last call; once per frame, after draw.
+	void end_frame() { m_stream.next_frame(); m_vertices_skipped = 0; }
+
+	// Compacts one arena page if fragmentation made its free space unusable; call once a frame.
+	bool defragment();
+
+	std::size_t get_vertex_count() const { return m_vertex_count; }
+	// Vertices of the face directions skipped by the draws since end_frame.
+	std::size_t get_vertices_skipped() const { return m_vertices_skipped; }
+	MeshArena::Stats get_arena_stats() const { return m_arena.get_stats(); }
+	const StreamBuffer::Stats& get_stream_stats() const { return m_stream.get_stats(); }
+
+private:
+	struct Allocation
+	{
+		MeshArena::Handle handle = 0; // valid when vertex_count > 0
+		std::uint32_t vertex_count = 0;
+		std::array<std::uint32_t, 6> face_vertex_counts{}; // see ChunkMeshData
+		bool resident = false;
+	};
+	using LodMeshes = std::array<Allocation, CHUNK_LOD_COUNT>;
+
+	// Layout fixed by glMultiDrawElementsIndirect.
+	struct DrawCommand
+	{
+		std::uint32_t count;
+		std::uint32_t instance_count;
+		std::uint32_t first_index;
+		std::int32_t base_vertex;
+		std::uint32_t base_instance;
+	};
+
+	void release(Allocation& mesh);
+	const Allocation* find(glm::ivec3 pos, int lod) const;
+	// Draw data into the stream buffer; false if it is full this frame.
+	bool stream_draw_data(std::size_t& commands_offset);
+
+	MeshArena m_arena;
+	VertexArray m_vao;
+	std::shared_ptr<IndexBuffer> m_index_buffer; // attached to m_vao
+	StreamBuffer m_stream;
+	std::size_t m_storage_alignment = 256; // GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT
+	Buffer m_origins;  // used when the stream buffer is full
+	Buffer m_commands;
+
+	ChunkMap<LodMeshes> m_meshes;
+	std::uint32_t m_max_quads = 0; // largest mesh so far, the shared index buffer must cover it
+	std::size_t m_vertex_count = 0;
+	std::size_t m_vertices_skipped = 0;
+
+	std::vector<std::vector<DrawCommand>> m_page_commands; // draw scratch
+	std::vector<DrawCommand> m_command_data;
+	std::vector<glm::vec4> m_origin_data;
+};
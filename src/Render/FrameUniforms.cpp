@@ -0,0 +1,22 @@
+#include "FrameUniforms.hpp"
+
+#include <glad/gl.h>
+
+#include <OpenGL/ShaderProgram.hpp>
+
+
+FrameUniforms::FrameUniforms()
+	: m_buffer(sizeof(Data), nullptr, VertexBuffer::EUsage::Dynamic)
+{
+}
+
+void FrameUniforms::update(const Camera& camera, float time)
+{
+	m_data.view = camera.get_view_matrix();
+	m_data.projection = camera.get_projection_matrix();
+	m_data.projview = m_data.projection * m_data.view;
+	m_data.camera_position = glm::vec4(camera.get_position(), time);
+
+	m_buffer.set_sub_data(0, &m_data, sizeof(Data));
+	m_buffer.bind_base(GL_UNIFORM_BUFFER, ShaderProgram::FRAME_UNIFORMS_BINDING);
+}
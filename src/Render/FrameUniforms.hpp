@@ -0,0 +1,35 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include <OpenGL/Buffer.hpp>
+#include <Render/Camera.hpp>
+
+
+// Per-frame values shared by every program that declares the std140 block
+// ShaderProgram::FRAME_UNIFORMS_BLOCK. Written and bound once per frame instead of
+// being set on each program. Context thread only.
+class FrameUniforms
+{
+public:
+	FrameUniforms();
+
+	// Uploads the camera's matrices and binds the buffer to FRAME_UNIFORMS_BINDING.
+	void update(const Camera& camera, float time);
+
+	const glm::mat4& get_projview() const { return m_data.projview; }
+
+private:
+	// Mirrors the GLSL block; std140 lays mat4 and vec4 out without padding.
+	struct Data
+	{
+		glm::mat4 projview;
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec4 camera_position; // w - time in seconds
+	};
+
+	Data m_data{};
+	Buffer m_buffer;
+};
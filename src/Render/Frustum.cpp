@@ -0,0 +1,36 @@
+#include "Frustum.hpp"
+
+#include <glm/glm.hpp>
+
+
+Frustum::Frustum(const glm::mat4& projview)
+{
+    // Gribb/Hartmann: planes are sums and differences of the matrix rows.
+    const auto row = [&](int i) {
+        return glm::vec4(projview[0][i], projview[1][i], projview[2][i], projview[3][i]);
+    };
+
+    m_planes[0] = row(3) + row(0); // left
+    m_planes[1] = row(3) - row(0); // right
+    m_planes[2] = row(3) + row(1); // bottom
+    m_planes[3] = row(3) - row(1); // top
+    m_planes[4] = row(3) + row(2); // near
+    m_planes[5] = row(3) - row(2); // far
+}
+
+bool Frustum::intersects_aabb(const glm::vec3& min, const glm::vec3& max) const
+{
+    for (const glm::vec4& plane : m_planes)
+    {
+        // Corner furthest along the plane normal; if even it is behind, the whole box is.
+        const glm::vec3 p = {
+            plane.x >= 0.f ? max.x : min.x,
+            plane.y >= 0.f ? max.y : min.y,
+            plane.z >= 0.f ? max.z : min.z
+        };
+
+        if (plane.x * p.x + plane.y * p.y + plane.z * p.z + plane.w < 0.f)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <array>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/ext/matrix_float4x4.hpp>
+
+// View frustum as six inward facing planes taken from a projection*view matrix.
+class Frustum
+{
+public:
+    explicit Frustum(const glm::mat4& projview);
+
+    // Conservative: boxes straddling a plane count as visible.
+    bool intersects_aabb(const glm::vec3& min, const glm::vec3& max) const;
+
+private:
+    std::array<glm::vec4, 6> m_planes; // xyz - normal, w - distance
+};
@@ -0,0 +1,172 @@
+#include "MeshArena.hpp"
+
+#include <algorithm>
+
+#include <glad/gl.h>
+
+
+MeshArena::MeshArena(BufferLayout layout, std::uint32_t page_capacity)
+	: m_layout(std::move(layout)),
+	  m_page_capacity(page_capacity)
+{
+	add_page(m_page_capacity);
+}
+
+MeshArena::Handle MeshArena::allocate(const void* data, std::uint32_t count)
+{
+	const Handle handle = allocate(count);
+	const Location& location = m_allocations[handle];
+	const std::size_t stride = m_layout.get_stride();
+	m_pages[location.page].buffer->set_sub_data(location.first * stride, data, count * stride);
+	return handle;
+}
+
+MeshArena::Handle MeshArena::allocate(std::uint32_t count)
+{
+	Location location{ 0, 0, count };
+	while (location.page < m_pages.size() && !allocate_in(m_pages[location.page], count, location.first))
+		location.page++;
+
+	if (location.page == m_pages.size()) {
+		add_page(std::max(m_page_capacity, count));
+		allocate_in(m_pages.back(), count, location.first);
+	}
+
+	Handle handle;
+	if (!m_free_handles.empty()) {
+		handle = m_free_handles.back();
+		m_free_handles.pop_back();
+		m_allocations[handle] = location;
+	}
+	else {
+		handle = static_cast<Handle>(m_allocations.size());
+		m_allocations.push_back(location);
+	}
+	return handle;
+}
+
+void MeshArena::release(Handle handle)
+{
+	Location& location = m_allocations[handle];
+	release_in(m_pages[location.page], location.first, location.count);
+	location = {};
+	m_free_handles.push_back(handle);
+}
+
+bool MeshArena::defragment(float threshold)
+{
+	Page* target = nullptr;
+	std::uint32_t target_waste = 0;
+	for (auto& page : m_pages) {
+		const std::uint32_t free = page.capacity - page.used;
+		const std::uint32_t waste = free - largest_free(page);
+		// Small pockets of waste are not worth copying the whole page for.
+		if (waste >= page.capacity / 4 && static_cast<float>(waste) > threshold * free && waste > target_waste) {
+			target = &page;
+			target_waste = waste;
+		}
+	}
+	if (!target) return false;
+
+	const std::uint32_t page_index = static_cast<std::uint32_t>(target - m_pages.data());
+	std::vector<Location*> live;
+	for (auto& location : m_allocations)
+		if (location.count > 0 && location.page == page_index)
+			live.push_back(&location);
+	std::sort(live.begin(), live.end(), [](const Location* a, const Location* b) { return a->first < b->first; });
+
+	// Overlapping copies within one buffer are not allowed, so the page moves to new storage.
+	auto buffer = std::make_unique<VertexBuffer>(nullptr, std::size_t{ target->capacity } * m_layout.get_stride(), m_layout,
+												 VertexBuffer::EUsage::Immutable);
+	const std::size_t stride = m_layout.get_stride();
+	std::uint32_t next = 0;
+	for (Location* location : live) {
+		glCopyNamedBufferSubData(target->buffer->get_handle(), buffer->get_handle(),
+								 static_cast<GLintptr>(location->first * stride), static_cast<GLintptr>(next * stride),
+								 static_cast<GLsizeiptr>(location->count * stride));
+		location->first = next;
+		next += location->count;
+	}
+
+	m_moved += next;
+	target->buffer = std::move(buffer);
+	target->free.clear();
+	if (next < target->capacity)
+		target->free.emplace(next, target->capacity - next);
+	return true;
+}
+
+MeshArena::Stats MeshArena::get_stats() const
+{
+	Stats stats;
+	stats.pages = m_pages.size();
+	stats.moved = m_moved;
+	std::size_t usable = 0;
+	for (const auto& page : m_pages) {
+		const std::uint32_t largest = largest_free(page);
+		stats.capacity += page.capacity;
+		stats.used += page.used;
+		stats.largest_free = std::max<std::size_t>(stats.largest_free, largest);
+		usable += largest;
+	}
+
+	const std::size_t free = stats.capacity - stats.used;
+	if (free > 0)
+		stats.fragmentation = 1.f - static_cast<float>(usable) / static_cast<float>(free);
+	return stats;
+}
+
+std::uint32_t MeshArena::largest_free(const Page& page)
+{
+	std::uint32_t largest = 0;
+	for (const auto& [first, count] : page.free)
+		largest = std::max(largest, count);
+	return largest;
+}
+
+bool MeshArena::allocate_in(Page& page, std::uint32_t count, std::uint32_t& first)
+{
+	if (page.capacity - page.used < count) return false;
+
+	const auto it = std::find_if(page.free.begin(), page.free.end(), [&](const auto& range) { return range.second >= count; });
+	if (it == page.free.end()) return false;
+
+	const auto [range_first, range_count] = *it;
+	page.free.erase(it);
+	if (range_count > count)
+		page.free.emplace(range_first + count, range_count - count);
+
+	page.used += count;
+	first = range_first;
+	return true;
+}
+
+void MeshArena::release_in(Page& page, std::uint32_t first, std::uint32_t count)
+{
+	page.used -= count;
+
+	auto next = page.free.lower_bound(first);
+	if (next != page.free.end() && first + count == next->first) {
+		count += next->second;
+		next = page.free.erase(next);
+	}
+	if (next != page.free.begin()) {
+		const auto prev = std::prev(next);
+		if (prev->first + prev->second == first) {
+			first = prev->first;
+			count += prev->second;
+			page.free.erase(prev);
+		}
+	}
+	page.free.emplace(first, count);
+}
+
+void MeshArena::add_page(std::uint32_t capacity)
+{
+	Page page;
+	page.buffer = std::make_unique<VertexBuffer>(nullptr, std::size_t{ capacity } * m_layout.get_stride(), m_layout,
+												 VertexBuffer::EUsage::Immutable);
+	page.capacity = capacity;
+	page.free.emplace(0, capacity);
+	m_pages.push_back(std::move(page));
+}
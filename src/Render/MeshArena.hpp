@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <OpenGL/VertexBuffer.hpp>
+
+
+// Sub-allocates vertex storage from a few large immutable buffers (pages), so meshes
+// coming and going while chunks stream in and out do not create or free GL buffers.
+// Sizes and offsets are in vertices of the arena's layout. Allocations are addressed
+// by handle because defragmentation moves them. Context thread only.
+class MeshArena
+{
+public:
+	using Handle = std::uint32_t;
+
+	struct Location
+	{
+		std::uint32_t page = 0;
+		std::uint32_t first = 0;
+		std::uint32_t count = 0;
+	};
+
+	struct Stats
+	{
+		std::size_t pages = 0;
+		std::size_t capacity = 0;
+		std::size_t used = 0;
+		std::size_t largest_free = 0;
+		float fragmentation = 0.f; // share of the free space outside each page's largest free range
+		std::size_t moved = 0;     // vertices copied by defragmentation so far
+	};
+
+	MeshArena(BufferLayout layout, std::uint32_t page_capacity);
+
+	// First fit over the pages in order; a new page is added when none has room.
+	// Meshes larger than a page get a page of their own size. Without data the range is
+	// left for the caller to fill, e.g. by a GPU copy.
+	Handle allocate(std::uint32_t count);
+	Handle allocate(const void* data, std::uint32_t count);
+	void release(Handle handle);
+	const Location& get(Handle handle) const { return m_allocations[handle]; }
+
+	std::size_t get_page_count() const { return m_pages.size(); }
+	const VertexBuffer& get_page(std::uint32_t page) const { return *m_pages[page].buffer; }
+
+	// Copies the live ranges of the page with the most unusable free space into fresh
+	// storage back to back, if more than threshold of its free space lies outside its
+	// largest free range and that waste is at least a quarter of the page. One page per
+	// call at most, so the cost per frame stays bounded. Returns whether a page was compacted.
+	bool defragment(float threshold);
+
+	Stats get_stats() const;
+
+private:
+	struct Page
+	{
+		std::unique_ptr<VertexBuffer> buffer;
+		std::uint32_t capacity = 0;
+		std::uint32_t used = 0;
+		std::map<std::uint32_t, std::uint32_t> free; // first -> count, never adjacent
+	};
+
+	static std::uint32_t largest_free(const Page& page);
+	static bool allocate_in(Page& page, std::uint32_t count, std::uint32_t& first);
+	static void release_in(Page& page, std::uint32_t first, std::uint32_t count);
+
+	void add_page(std::uint32_t capacity);
+
+	BufferLayout m_layout;
+	std::uint32_t m_page_capacity;
+	std::vector<Page> m_pages;
+	std::vector<Location> m_allocations; // by handle, count 0 when free
+	std::vector<Handle> m_free_handles;
+	std::size_t m_moved = 0;
+};
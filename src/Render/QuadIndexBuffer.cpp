@@ -0,0 +1,40 @@
+#include "QuadIndexBuffer.hpp"
+
+#include <cstdint>
+#include <vector>
+
+template <typename T>
+static std::vector<T> make_quad_indices(std::size_t quad_count)
+{
+	std::vector<T> indices;
+	indices.reserve(quad_count * QuadIndexBuffer::INDICES_PER_QUAD);
+
+	for (std::size_t q = 0; q < quad_count; q++) {
+		const T base = static_cast<T>(q * QuadIndexBuffer::VERTICES_PER_QUAD);
+		indices.insert(indices.end(), { base, T(base + 1), T(base + 2), base, T(base + 2), T(base + 3) });
+	}
+	return indices;
+}
+
+std::shared_ptr<IndexBuffer> QuadIndexBuffer::get(std::size_t quad_count)
+{
+	if (m_buffer && quad_count <= m_quad_count)
+		return m_buffer;
+
+	std::size_t capacity = 1024;
+	while (capacity < quad_count) capacity *= 2;
+
+	const std::size_t max_quads_16 = (std::size_t{ UINT16_MAX } + 1) / VERTICES_PER_QUAD;
+
+	if (capacity <= max_quads_16) {
+		auto indices = make_quad_indices<std::uint16_t>(capacity);
+		m_buffer = std::make_shared<IndexBuffer>(indices.data(), indices.size(), IndexBuffer::EType::UInt16);
+	}
+	else {
+		auto indices = make_quad_indices<std::uint32_t>(capacity);
+		m_buffer = std::make_shared<IndexBuffer>(indices.data(), indices.size(), IndexBuffer::EType::UInt32);
+	}
+
+	m_quad_count = capacity;
+	return m_buffer;
+}
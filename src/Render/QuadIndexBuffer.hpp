@@ -0,0 +1,26 @@
+#pragma once
+
+#include <memory>
+
+#include <OpenGL/IndexBuffer.hpp>
+
+// Engine-wide index buffer for meshes made of quads stored as 4 vertices each
+// (a, b, c, d -> triangles a b c, a c d). Shared by every chunk mesh.
+class QuadIndexBuffer
+{
+public:
+	QuadIndexBuffer() = delete;
+
+	static constexpr std::size_t INDICES_PER_QUAD = 6;
+	static constexpr std::size_t VERTICES_PER_QUAD = 4;
+
+	// Buffer that covers at least quad_count quads; 16-bit while the vertices fit.
+	// Grows by replacement, meshes keep the buffer they were built with alive.
+	static std::shared_ptr<IndexBuffer> get(std::size_t quad_count);
+
+	static void destroy() { m_buffer.reset(); m_quad_count = 0; }
+
+private:
+	static inline std::shared_ptr<IndexBuffer> m_buffer;
+	static inline std::size_t m_quad_count = 0;
+};
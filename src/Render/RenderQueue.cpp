@@ -0,0 +1,48 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+
+void RenderQueue::clear()
+{
+	m_items.clear();
+	m_shaders.clear();
+	m_textures.clear();
+}
+
+void RenderQueue::push(EPass pass, const ShaderProgram& shader, const Texture2D& texture, std::uint32_t group, float depth,
+					   std::uint32_t payload)
+{
+	assert(group < MAX_STATES);
+
+	// Non-negative floats order like their bit patterns.
+	std::uint32_t depth_bits = std::bit_cast<std::uint32_t>(std::max(depth, 0.f));
+	if (pass == EPass::Transparent) depth_bits = ~depth_bits;
+
+	const std::uint64_t state = std::uint64_t{ static_cast<std::uint8_t>(pass) } << PASS_SHIFT
+							  | std::uint64_t{ intern(m_shaders, &shader) } << SHADER_SHIFT
+							  | std::uint64_t{ intern(m_textures, &texture) } << TEXTURE_SHIFT
+							  | (group & STATE_MASK);
+
+	m_items.push_back({ state << DEPTH_BITS | depth_bits, payload });
+}
+
+void RenderQueue::sort()
+{
+	std::sort(m_items.begin(), m_items.end(), [](const Item& a, const Item& b) { return a.key < b.key; });
+}
+
+// A frame uses a handful of shaders and textures, a linear search beats hashing.
+template <typename T>
+std::uint32_t RenderQueue::intern(std::vector<const T*>& table, const T* object)
+{
+	const auto it = std::find(table.begin(), table.end(), object);
+	if (it != table.end())
+		return static_cast<std::uint32_t>(it - table.begin());
+
+	assert(table.size() < MAX_STATES);
+	table.push_back(object);
+	return static_cast<std::uint32_t>(table.size() - 1);
+}
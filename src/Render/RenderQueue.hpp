@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <OpenGL/ShaderProgram.hpp>
+#include <Render/Texture2D.hpp>
+
+
+// Draw items of one frame, sorted by a 64-bit key so that items sharing GL state end
+// up next to each other:
+//   pass (2 bits) | shader (10) | texture (10) | group (10) | depth (32)
+// Shaders and textures are numbered in order of first use since clear(); group is a
+// binding chosen by the caller, such as the vertex buffer an item lives in. Opaque
+// items sort front to back for early depth rejection, transparent ones back to front.
+class RenderQueue
+{
+public:
+	enum class EPass : std::uint8_t
+	{
+		Opaque,
+		Transparent
+	};
+
+	static constexpr std::uint32_t MAX_STATES = 1u << 10; // per shader, texture and group
+
+	struct Item
+	{
+		std::uint64_t key;
+		std::uint32_t payload; // caller's index of what to draw
+	};
+
+	// Run of sorted items with the same pass, shader, texture and group.
+	struct Batch
+	{
+		const ShaderProgram* shader;
+		const Texture2D* texture;
+		std::uint32_t group;
+		std::span<const Item> items;
+	};
+
+	void clear();
+	void push(EPass pass, const ShaderProgram& shader, const Texture2D& texture, std::uint32_t group, float depth,
+			  std::uint32_t payload);
+	void sort();
+
+	// Binds each batch's shader and texture through GLState, so only changes reach GL,
+	// then calls fn(const Batch&) to draw it. Returns the number of batches.
+	template <typename F>
+	std::size_t submit(F&& fn) const
+	{
+		std::size_t batches = 0;
+
+		for (std::size_t begin = 0; begin < m_items.size(); batches++) {
+			const std::uint64_t state = m_items[begin].key >> DEPTH_BITS;
+			std::size_t end = begin + 1;
+			while (end < m_items.size() && (m_items[end].key >> DEPTH_BITS) == state) end++;
+
+			Batch batch;
+			batch.shader = m_shaders[(state >> SHADER_SHIFT) & STATE_MASK];
+			batch.texture = m_textures[(state >> TEXTURE_SHIFT) & STATE_MASK];
+			batch.group = static_cast<std::uint32_t>(state & STATE_MASK);
+			batch.items = std::span<const Item>(m_items.data() + begin, end - begin);
+
+			batch.shader->bind();
+			batch.texture->bind();
+			fn(batch);
+			begin = end;
+		}
+		return batches;
+	}
+
+	std::size_t size() const { return m_items.size(); }
+
+private:
+	static constexpr int DEPTH_BITS = 32;
+	static constexpr int TEXTURE_SHIFT = 10; // within the state, the bits above depth
+	static constexpr int SHADER_SHIFT = 20;
+	static constexpr int PASS_SHIFT = 30;
+	static constexpr std::uint64_t STATE_MASK = MAX_STATES - 1;
+
+	template <typename T>
+	static std::uint32_t intern(std::vector<const T*>& table, const T* object);
+
+	std::vector<Item> m_items;
+	std::vector<const ShaderProgram*> m_shaders;
+	std::vector<const Texture2D*> m_textures;
+};
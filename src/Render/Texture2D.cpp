@@ -1,5 +1,7 @@
 #include "Texture2D.hpp"
 
+#include <OpenGL/GLState.hpp>
+
 
 Texture2D::Texture2D(const GLuint width, 
 					 const GLuint height, 
@@ -20,9 +22,9 @@ Texture2D::Texture2D(const GLuint width,
 		m_mode = GL_RGB;
 	}
 
-	glGenTextures(1, &m_id);
+	glCreateTextures(GL_TEXTURE_2D, 1, &m_id); // created with its target, so it can be bound to a unit
 	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, m_id);
+	GLState::bind_texture(0, m_id);
 	glTexImage2D(GL_TEXTURE_2D, 0, m_mode, m_width, m_height, 0, m_mode, GL_UNSIGNED_BYTE, data);
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
@@ -31,11 +33,12 @@ Texture2D::Texture2D(const GLuint width,
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
 	glGenerateMipmap(GL_TEXTURE_2D);
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	GLState::bind_texture(0, 0);
 }
 
 Texture2D::~Texture2D()
 {
+	GLState::forget_texture(m_id);
 	glDeleteTextures(1, &m_id);
 }
 
@@ -53,6 +56,7 @@ Texture2D& Texture2D::operator=(Texture2D&& obj) noexcept
 	if (this == &obj)
 		return *this;
 
+	GLState::forget_texture(m_id);
 	glDeleteTextures(1, &m_id);
 	m_id = obj.m_id;
 	m_width = obj.m_width;
@@ -63,7 +67,7 @@ Texture2D& Texture2D::operator=(Texture2D&& obj) noexcept
 	return *this;
 }
 
-void Texture2D::bind() const
+void Texture2D::bind(const unsigned int unit) const
 {
-	glBindTexture(GL_TEXTURE_2D, m_id);
+	GLState::bind_texture(unit, m_id);
 }
\ No newline at end of file
@@ -24,7 +24,8 @@ public:
 	const unsigned int get_width() const noexcept { return m_width; }
 	const unsigned int get_height() const noexcept { return m_height; }
 
-	void bind() const;
+	void bind(const unsigned int unit = 0) const;
+	GLuint get_id() const noexcept { return m_id; }
 
 
 private:
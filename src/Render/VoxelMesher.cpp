@@ -1,57 +1,333 @@
 ﻿#include "VoxelMesher.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+// SSE2 is part of x86-64; AVX2 is used when the build targets it.
+#if defined(__SSE2__) || defined(_M_X64)
+#define MESHER_SSE2 1
+#include <immintrin.h>
+#endif
+
 #include <Voxel/Voxel.hpp>
 
-#include <common/ImGuiWrapper.hpp>
-#include <common/Log.hpp>
 
 
+// Face direction as (normal axis, step along it, tangent axes of the quad plane).
+struct FaceDir
+{
+    ChunkFace face;
+    int axis, step;
+    int u_axis, v_axis;
+};
 
-struct ChunkVertex
+static constexpr FaceDir FACE_DIRS[] = {
+    { ChunkFace::Top,    1,  1, 0, 2 },
+    { ChunkFace::Bottom, 1, -1, 0, 2 },
+    { ChunkFace::PosX,   0,  1, 2, 1 },
+    { ChunkFace::NegX,   0, -1, 2, 1 },
+    { ChunkFace::PosZ,   2,  1, 0, 1 },
+    { ChunkFace::NegZ,   2, -1, 0, 1 },
+};
+
+// What a face must share with its neighbours to be merged into one quad.
+struct FaceKey
 {
-    float x, y, z;  // pos
-    float u, v;     // uv
-    float l;        // light
+    std::uint16_t id = 0;
+    std::uint8_t light = 0;
+
+    bool operator==(const FaceKey&) const = default;
 };
 
-static inline int cdiv(int x, int a) { return (x < 0) ? (x / a - 1) : (x / a); }
+// Per chunk meshing input: the ids of the chunk, its occupancy as one bitmask per row
+// along X with a one voxel border taken from the 26 neighbours, and the visible faces
+// of every row per direction. Missing neighbours read as air.
+template <typename ChunkT>
+struct MeshScratch
+{
+    static constexpr int CX = static_cast<int>(ChunkT::CHUNK_X);
+    static constexpr int CY = static_cast<int>(ChunkT::CHUNK_Y);
+    static constexpr int CZ = static_cast<int>(ChunkT::CHUNK_Z);
+
+    static_assert(CX + 2 <= 64, "padded occupancy rows must fit in 64 bits");
 
-static inline int local_neg(int x, int size) { return (x < 0) ? (size + x) : x; }
-static inline int local(int x, int size) { return (x >= size) ? (x - size) : local_neg(x, size); }
+    static constexpr int SY = CY + 2;
+    static constexpr int SZ = CZ + 2;
 
-static inline std::shared_ptr<Chunk> get_chunk(
-    int x, int y, int z,
-    const std::vector<std::shared_ptr<Chunk>>& chunks)
+    static constexpr int index(int x, int y, int z) { return x + CX * (y + CY * z); }
+    static constexpr int row(int y, int z) { return y + CY * z; }
+    // Takes chunk local coordinates, -1 and CHUNK_* address the border.
+    static constexpr int padded_row(int y, int z) { return (y + 1) + SY * (z + 1); }
+
+    std::uint16_t ids[CX * CY * CZ];
+    // Bit x + 1 is voxel x; bits 0 and CX + 1 are the X neighbours.
+    std::uint64_t solid[SY * SZ];
+    // Bit x is a visible face of voxel x, indexed like FACE_DIRS.
+    std::uint64_t faces[6][CY * CZ];
+};
+
+static inline int neighbour_offset(int v, int size) { return (v < 0) ? -1 : (v >= size ? 1 : 0); }
+
+template <typename ChunkT>
+static void fill_scratch(const BasicChunkNeighbourhood<ChunkT>& chunks, MeshScratch<ChunkT>& scratch)
 {
-    int cx = cdiv(x, Chunk::CHUNK_X) + 1; // 0..2
-    int cy = cdiv(y, Chunk::CHUNK_Y) + 1; // 0..2
-    int cz = cdiv(z, Chunk::CHUNK_Z) + 1; // 0..2
+    using Scratch = MeshScratch<ChunkT>;
+
+    // The chunk itself in its own storage order, which is sequential whatever the layout.
+    if (const ChunkT* center = chunks.center().get())
+        center->for_each_voxel([&](int x, int y, int z, std::uint16_t id) { scratch.ids[Scratch::index(x, y, z)] = id; });
+    else
+        std::fill(std::begin(scratch.ids), std::end(scratch.ids), std::uint16_t{ 0 });
 
-    if (cx < 0 || cx > 2 || cy < 0 || cy > 2 || cz < 0 || cz > 2)
-        return nullptr;
+    const ChunkT* neg_x = chunks.get(-1, 0, 0).get();
+    const ChunkT* pos_x = chunks.get(1, 0, 0).get();
 
-    int i = cx + 3 * cz + 9 * cy;             // X fastest, then Z, then Y
+    for (int z = -1; z <= Scratch::CZ; z++)
+        for (int y = -1; y <= Scratch::CY; y++)
+        {
+            const int cy = neighbour_offset(y, Scratch::CY);
+            const int cz = neighbour_offset(z, Scratch::CZ);
+            const ChunkT* chunk = chunks.get(0, cy, cz).get();
 
-    return chunks[i];
+            std::uint64_t bits = chunk ? chunk->get_solid_row(y - cy * Scratch::CY, z - cz * Scratch::CZ) << 1 : 0;
+
+            // Only the chunk's own rows are ever tested against X neighbours.
+            if (cy == 0 && cz == 0)
+            {
+                if (neg_x) bits |= (neg_x->get_solid_row(y, z) >> (Scratch::CX - 1)) & 1;
+                if (pos_x) bits |= (pos_x->get_solid_row(y, z) & 1) << (Scratch::CX + 1);
+            }
+            scratch.solid[Scratch::padded_row(y, z)] = bits;
+        }
 }
 
-static inline bool is_chunk(int x, int y, int z, const std::vector<std::shared_ptr<Chunk>>& chunks)
+// Dimensions of ChunkT downsampled by Factor, all MeshScratch and compute_faces need.
+template <typename ChunkT, int Factor>
+struct CoarseChunk
+{
+    static_assert(ChunkT::CHUNK_X % Factor == 0 && ChunkT::CHUNK_Y % Factor == 0 && ChunkT::CHUNK_Z % Factor == 0,
+                  "chunk too small for the LOD factor");
+
+    static constexpr std::size_t CHUNK_X = ChunkT::CHUNK_X / Factor;
+    static constexpr std::size_t CHUNK_Y = ChunkT::CHUNK_Y / Factor;
+    static constexpr std::size_t CHUNK_Z = ChunkT::CHUNK_Z / Factor;
+    static constexpr std::uint64_t ROW_MASK = (1ull << CHUNK_X) - 1;
+};
+
+static inline bool all_set(std::uint64_t row, int first, int count)
 {
-    auto ch = get_chunk(x, y, z, chunks);
-    return ch != nullptr;
+    const std::uint64_t mask = ((1ull << count) - 1) << first;
+    return (row & mask) == mask;
 }
 
-static inline int voxel(int x, int y, int z, const std::vector<std::shared_ptr<Chunk>>& chunks)
+// Id of a coarse cell: the most common id among the topmost solid voxel of each
+// column of the block, so surfaces keep the material seen from above (grass over dirt).
+template <typename Scratch, int Factor>
+static std::uint16_t downsample_id(const Scratch& fine, int x0, int y0, int z0)
 {
-    int i = (local(y, Chunk::CHUNK_Y) * Chunk::CHUNK_Z + local(z, Chunk::CHUNK_Z)) * Chunk::CHUNK_X + local(x, Chunk::CHUNK_X);
-    auto zz = get_chunk(x, y, z, chunks)->get_voxels()[i].id;
-    return zz;
+    std::uint16_t ids[Factor * Factor];
+    int counts[Factor * Factor];
+    int distinct = 0;
+
+    for (int z = z0; z < z0 + Factor; z++)
+        for (int x = x0; x < x0 + Factor; x++)
+            for (int y = y0 + Factor - 1; y >= y0; y--)
+            {
+                const std::uint16_t id = fine.ids[Scratch::index(x, y, z)];
+                if (id == 0) continue;
+
+                int i = 0;
+                while (i < distinct && ids[i] != id) i++;
+                if (i == distinct) { ids[distinct] = id; counts[distinct++] = 0; }
+                counts[i]++;
+                break;
+            }
+
+    int best = 0;
+    for (int i = 1; i < distinct; i++)
+        if (counts[i] > counts[best]) best = i;
+    return distinct ? ids[best] : 0;
 }
 
-static inline bool is_blocked(std::shared_ptr<Chunk> chunk, int x, int y, int z, const std::vector<std::shared_ptr<Chunk>>& chunks)
+// Fills a scratch downsampled by Factor from the full resolution chunks. A coarse cell
+// is solid when any voxel of its block is, so every level covers the levels below it.
+// A border face is culled only when all voxels behind it in the neighbour are solid:
+// the neighbour covers them at whatever level it is drawn, so levels never crack.
+template <typename ChunkT, int Factor>
+static void fill_coarse_scratch(const BasicChunkNeighbourhood<ChunkT>& chunks, MeshScratch<ChunkT>& fine,
+                                MeshScratch<CoarseChunk<ChunkT, Factor>>& scratch)
 {
-    bool ch = is_chunk(x, y, z, chunks);
-    return (ch && voxel(x, y, z, chunks));
+    using Fine = MeshScratch<ChunkT>;
+    using Scratch = MeshScratch<CoarseChunk<ChunkT, Factor>>;
+
+    if (const ChunkT* center = chunks.center().get())
+        center->for_each_voxel([&](int x, int y, int z, std::uint16_t id) { fine.ids[Fine::index(x, y, z)] = id; });
+    else
+        std::fill(std::begin(fine.ids), std::end(fine.ids), std::uint16_t{ 0 });
+
+    std::fill(std::begin(scratch.solid), std::end(scratch.solid), std::uint64_t{ 0 });
+
+    for (int z = 0; z < Scratch::CZ; z++)
+        for (int y = 0; y < Scratch::CY; y++)
+        {
+            std::uint64_t bits = 0;
+            for (int x = 0; x < Scratch::CX; x++)
+            {
+                const std::uint16_t id = downsample_id<Fine, Factor>(fine, x * Factor, y * Factor, z * Factor);
+                scratch.ids[Scratch::index(x, y, z)] = id;
+                if (id != 0) bits |= 1ull << (x + 1);
+            }
+            scratch.solid[Scratch::padded_row(y, z)] = bits;
+        }
+
+    const ChunkT* neg_y = chunks.get(0, -1, 0).get();
+    const ChunkT* pos_y = chunks.get(0, 1, 0).get();
+    const ChunkT* neg_z = chunks.get(0, 0, -1).get();
+    const ChunkT* pos_z = chunks.get(0, 0, 1).get();
+    const ChunkT* neg_x = chunks.get(-1, 0, 0).get();
+    const ChunkT* pos_x = chunks.get(1, 0, 0).get();
+
+    // Y and Z neighbours: the block's rows of the neighbour's first layer must be full.
+    for (int c = 0; c < Scratch::CZ; c++)
+        for (int x = 0; x < Scratch::CX; x++)
+        {
+            bool below = neg_y != nullptr, above = pos_y != nullptr;
+            for (int f = c * Factor; f < (c + 1) * Factor; f++)
+            {
+                below = below && all_set(neg_y->get_solid_row(Fine::CY - 1, f), x * Factor, Factor);
+                above = above && all_set(pos_y->get_solid_row(0, f), x * Factor, Factor);
+            }
+            if (below) scratch.solid[Scratch::padded_row(-1, c)] |= 1ull << (x + 1);
+            if (above) scratch.solid[Scratch::padded_row(Scratch::CY, c)] |= 1ull << (x + 1);
+        }
+
+    for (int c = 0; c < Scratch::CY; c++)
+        for (int x = 0; x < Scratch::CX; x++)
+        {
+            bool back = neg_z != nullptr, front = pos_z != nullptr;
+            for (int f = c * Factor; f < (c + 1) * Factor; f++)
+            {
+                back = back && all_set(neg_z->get_solid_row(f, Fine::CZ - 1), x * Factor, Factor);
+                front = front && all_set(pos_z->get_solid_row(f, 0), x * Factor, Factor);
+            }
+            if (back) scratch.solid[Scratch::padded_row(c, -1)] |= 1ull << (x + 1);
+            if (front) scratch.solid[Scratch::padded_row(c, Scratch::CZ)] |= 1ull << (x + 1);
+        }
+
+    // X neighbours: one bit per row of the block, at the neighbour's near edge.
+    for (int z = 0; z < Scratch::CZ; z++)
+        for (int y = 0; y < Scratch::CY; y++)
+        {
+            bool left = neg_x != nullptr, right = pos_x != nullptr;
+            for (int fz = z * Factor; fz < (z + 1) * Factor; fz++)
+                for (int fy = y * Factor; fy < (y + 1) * Factor; fy++)
+                {
+                    left = left && ((neg_x->get_solid_row(fy, fz) >> (Fine::CX - 1)) & 1);
+                    right = right && (pos_x->get_solid_row(fy, fz) & 1);
+                }
+            if (left) scratch.solid[Scratch::padded_row(y, z)] |= 1;
+            if (right) scratch.solid[Scratch::padded_row(y, z)] |= 1ull << (Scratch::CX + 1);
+        }
+}
+
+// Lane types for face_rows, one to four 64-bit rows at a time.
+struct ScalarRows
+{
+    using R = std::uint64_t;
+    static constexpr int LANES = 1;
+
+    static R load(const std::uint64_t* p) { return *p; }
+    static void store(std::uint64_t* p, R v) { *p = v; }
+    static R set(std::uint64_t v) { return v; }
+    template <int N> static R shr(R v) { return v >> N; }
+    static R and_(R a, R b) { return a & b; }
+    static R and_not(R a, R b) { return a & ~b; }
+};
+
+#if defined(MESHER_SSE2)
+struct SSE2Rows
+{
+    using R = __m128i;
+    static constexpr int LANES = 2;
+
+    static R load(const std::uint64_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(std::uint64_t* p, R v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static R set(std::uint64_t v) { return _mm_set1_epi64x(static_cast<long long>(v)); }
+    template <int N> static R shr(R v) { return _mm_srli_epi64(v, N); }
+    static R and_(R a, R b) { return _mm_and_si128(a, b); }
+    static R and_not(R a, R b) { return _mm_andnot_si128(b, a); }
+};
+#endif
+
+#if defined(__AVX2__)
+struct AVX2Rows
+{
+    using R = __m256i;
+    static constexpr int LANES = 4;
+
+    static R load(const std::uint64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(std::uint64_t* p, R v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static R set(std::uint64_t v) { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+    template <int N> static R shr(R v) { return _mm256_srli_epi64(v, N); }
+    static R and_(R a, R b) { return _mm256_and_si256(a, b); }
+    static R and_not(R a, R b) { return _mm256_andnot_si256(b, a); }
+};
+#endif
+
+// Visible faces of rows [begin, count) of one Z layer: a solid voxel whose neighbour
+// across the face is not. Returns where it stopped, the rest is left to a narrower V.
+template <typename V>
+static int face_rows(const std::uint64_t* solid, int z_stride, std::uint64_t x_mask,
+                     std::uint64_t* const faces[6], int begin, int count)
+{
+    const auto mask = V::set(x_mask);
+
+    int i = begin;
+    for (; i + V::LANES <= count; i += V::LANES)
+    {
+        const auto row = V::load(solid + i);
+        const auto own = V::and_(V::template shr<1>(row), mask);
+
+        V::store(faces[0] + i, V::and_not(own, V::template shr<1>(V::load(solid + i + 1))));        // +Y
+        V::store(faces[1] + i, V::and_not(own, V::template shr<1>(V::load(solid + i - 1))));        // -Y
+        V::store(faces[2] + i, V::and_not(own, V::template shr<2>(row)));                           // +X
+        V::store(faces[3] + i, V::and_not(own, row));                                                // -X
+        V::store(faces[4] + i, V::and_not(own, V::template shr<1>(V::load(solid + i + z_stride)))); // +Z
+        V::store(faces[5] + i, V::and_not(own, V::template shr<1>(V::load(solid + i - z_stride)))); // -Z
+    }
+    return i;
+}
+
+// Fills scratch.faces and returns the number of visible faces.
+template <typename ChunkT>
+static std::size_t compute_faces(MeshScratch<ChunkT>& scratch)
+{
+    using Scratch = MeshScratch<ChunkT>;
+
+    std::size_t total = 0;
+    for (int z = 0; z < Scratch::CZ; z++)
+    {
+        const std::uint64_t* solid = &scratch.solid[Scratch::padded_row(0, z)];
+        std::uint64_t* const faces[6] = {
+            &scratch.faces[0][Scratch::row(0, z)], &scratch.faces[1][Scratch::row(0, z)], &scratch.faces[2][Scratch::row(0, z)],
+            &scratch.faces[3][Scratch::row(0, z)], &scratch.faces[4][Scratch::row(0, z)], &scratch.faces[5][Scratch::row(0, z)],
+        };
+
+        int y = 0;
+#if defined(__AVX2__)
+        y = face_rows<AVX2Rows>(solid, Scratch::SY, ChunkT::ROW_MASK, faces, y, Scratch::CY);
+#endif
+#if defined(MESHER_SSE2)
+        y = face_rows<SSE2Rows>(solid, Scratch::SY, ChunkT::ROW_MASK, faces, y, Scratch::CY);
+#endif
+        face_rows<ScalarRows>(solid, Scratch::SY, ChunkT::ROW_MASK, faces, y, Scratch::CY);
+
+        for (int d = 0; d < 6; d++)
+            for (int i = 0; i < Scratch::CY; i++)
+                total += std::popcount(faces[d][i]);
+    }
+    return total;
 }
 
 static inline void push_face(std::vector<ChunkVertex>& v,
@@ -60,111 +336,190 @@ static inline void push_face(std::vector<ChunkVertex>& v,
                              const ChunkVertex& c,
                              const ChunkVertex& d)
 {
+    // Drawn with the shared quad index buffer as a b c, a c d.
     v.push_back(a);
     v.push_back(b);
     v.push_back(c);
-    
-    v.push_back(a);
-    v.push_back(c);
     v.push_back(d);
 }
 
+// Emits a quad covering sx*sy*sz voxels starting at (x, y, z). The shader derives UVs
+// from the corner positions, so the tile repeats once per voxel across merged quads.
+static void push_quad(std::vector<ChunkVertex>& verts, const FaceDir& dir, std::uint16_t id, std::uint8_t light,
+                      int x, int y, int z, int sx, int sy, int sz)
+{
+    const std::uint32_t x0 = x, x1 = x + sx;
+    const std::uint32_t y0 = y, y1 = y + sy;
+    const std::uint32_t z0 = z, z1 = z + sz;
+
+    const auto makeV = [&](std::uint32_t px, std::uint32_t py, std::uint32_t pz, std::uint32_t corner) {
+        return ChunkVertex::pack(px, py, pz, dir.face, corner, id, light);
+    };
 
-std::shared_ptr<Mesh> VoxelMesher::build_mesh(std::shared_ptr<Chunk> chunk, const std::vector<std::shared_ptr<Chunk>>& chunks)
+    switch (dir.face)
+    {
+    case ChunkFace::Top:
+        push_face(verts, makeV(x0, y1, z0, 0), makeV(x0, y1, z1, 1), makeV(x1, y1, z1, 2), makeV(x1, y1, z0, 3));
+        break;
+    case ChunkFace::Bottom:
+        push_face(verts, makeV(x0, y0, z0, 0), makeV(x1, y0, z0, 1), makeV(x1, y0, z1, 2), makeV(x0, y0, z1, 3));
+        break;
+    case ChunkFace::PosX:
+        push_face(verts, makeV(x1, y0, z0, 0), makeV(x1, y1, z0, 1), makeV(x1, y1, z1, 2), makeV(x1, y0, z1, 3));
+        break;
+    case ChunkFace::NegX:
+        push_face(verts, makeV(x0, y0, z0, 0), makeV(x0, y0, z1, 1), makeV(x0, y1, z1, 2), makeV(x0, y1, z0, 3));
+        break;
+    case ChunkFace::PosZ:
+        push_face(verts, makeV(x0, y0, z1, 0), makeV(x1, y0, z1, 1), makeV(x1, y1, z1, 2), makeV(x0, y1, z1, 3));
+        break;
+    case ChunkFace::NegZ:
+        push_face(verts, makeV(x0, y0, z0, 0), makeV(x1, y0, z0, 1), makeV(x1, y1, z0, 2), makeV(x0, y1, z0, 3));
+        break;
+    }
+}
+
+
+// Faces of direction d, one quad each.
+template <typename ChunkT>
+static void build_naive(const MeshScratch<ChunkT>& scratch, int d, std::vector<ChunkVertex>& verts)
 {
-    std::vector<ChunkVertex> verts;
+    using Scratch = MeshScratch<ChunkT>;
 
-    constexpr float UVSIZE = 1.0f / 16.0f;
+    for (int z = 0; z < Scratch::CZ; z++)
+        for (int y = 0; y < Scratch::CY; y++)
+            for (std::uint64_t bits = scratch.faces[d][Scratch::row(y, z)]; bits; bits &= bits - 1)
+            {
+                const int x = std::countr_zero(bits);
+                push_quad(verts, FACE_DIRS[d], scratch.ids[Scratch::index(x, y, z)], ChunkVertex::MAX_LIGHT, x, y, z, 1, 1, 1);
+            }
+}
 
-    constexpr auto makeV = [](float px, float py, float pz, float uu, float vv, float light) {
-        return ChunkVertex{ px ,py,pz, uu,vv, light };
-    };
 
+// Sweeps every slice of the chunk along direction d, collects the visible faces of
+// the slice into a 2D mask and covers it with the largest rectangles of equal FaceKey.
+template <typename ChunkT>
+static void build_greedy(const MeshScratch<ChunkT>& scratch, int d, std::vector<FaceKey>& mask, std::vector<ChunkVertex>& verts)
+{
+    using Scratch = MeshScratch<ChunkT>;
+    constexpr int dims[3] = { Scratch::CX, Scratch::CY, Scratch::CZ };
+
+    const FaceDir& dir = FACE_DIRS[d];
+    const std::uint64_t* faces = scratch.faces[d];
+    if (std::all_of(faces, faces + Scratch::CY * Scratch::CZ, [](std::uint64_t bits) { return bits == 0; }))
+        return;
+
+    const int nu = dims[dir.u_axis];
+    const int nv = dims[dir.v_axis];
+    mask.assign(static_cast<std::size_t>(nu * nv), FaceKey{});
 
-    for (int y = 0; y < Chunk::CHUNK_Y; y++)
-        for (int z = 0; z < Chunk::CHUNK_Z; z++)
-            for (int x = 0; x < Chunk::CHUNK_X; x++)
+    for (int slice = 0; slice < dims[dir.axis]; slice++)
+    {
+        for (int v = 0; v < nv; v++)
+            for (int u = 0; u < nu; u++)
             {
-                auto id = chunk->get_id(x, y, z);
-                if (id == 0) continue;
+                glm::ivec3 p;
+                p[dir.axis] = slice;
+                p[dir.u_axis] = u;
+                p[dir.v_axis] = v;
 
-                float u = (id % 16) * UVSIZE;
-                float v = 1.0f - ((1 + id / 16) * UVSIZE);
+                if ((faces[Scratch::row(p.y, p.z)] >> p.x) & 1)
+                    mask[u + v * nu] = FaceKey{ scratch.ids[Scratch::index(p.x, p.y, p.z)], ChunkVertex::MAX_LIGHT };
+            }
 
+        for (int v = 0; v < nv; v++)
+            for (int u = 0; u < nu;)
+            {
+                const FaceKey key = mask[u + v * nu];
+                if (key.id == 0) { u++; continue; }
 
-                // TOP (+Y)
-                if (!is_blocked(chunk, x, y + 1, z, chunks)) {
-                    float l = 1.0f;
-                    auto a = makeV(x - 0.5f, y + 0.5f, z - 0.5f, u + UVSIZE, v, l);
-                    auto b = makeV(x - 0.5f, y + 0.5f, z + 0.5f, u + UVSIZE, v + UVSIZE, l);
-                    auto c = makeV(x + 0.5f, y + 0.5f, z + 0.5f, u, v + UVSIZE, l);
-                    auto d = makeV(x + 0.5f, y + 0.5f, z - 0.5f, u, v, l);
-                    push_face(verts, a, b, c, d);
-                }
+                int w = 1;
+                while (u + w < nu && mask[u + w + v * nu] == key) w++;
 
-                // BOTTOM (-Y)
-                if (!is_blocked(chunk, x, y - 1, z, chunks)) {
-                    float l = 0.75f;
-                    auto a = makeV(x - 0.5f, y - 0.5f, z - 0.5f, u, v, l);
-                    auto b = makeV(x + 0.5f, y - 0.5f, z - 0.5f, u + UVSIZE, v, l);
-                    auto c = makeV(x + 0.5f, y - 0.5f, z + 0.5f, u + UVSIZE, v + UVSIZE, l);
-                    auto d = makeV(x - 0.5f, y - 0.5f, z + 0.5f, u, v + UVSIZE, l);
-                    push_face(verts, a, b, c, d);
+                int h = 1;
+                for (; v + h < nv; h++)
+                {
+                    bool row_matches = true;
+                    for (int k = 0; k < w && row_matches; k++)
+                        row_matches = mask[u + k + (v + h) * nu] == key;
+                    if (!row_matches) break;
                 }
 
-                // +X
-                if (!is_blocked(chunk, x + 1, y, z, chunks)) {
-                    float l = 0.95f;
-                    auto a = makeV(x + 0.5f, y - 0.5f, z - 0.5f, u + UVSIZE, v, l);
-                    auto b = makeV(x + 0.5f, y + 0.5f, z - 0.5f, u + UVSIZE, v + UVSIZE, l);
-                    auto c = makeV(x + 0.5f, y + 0.5f, z + 0.5f, u, v + UVSIZE, l);
-                    auto d = makeV(x + 0.5f, y - 0.5f, z + 0.5f, u, v, l);
-                    push_face(verts, a, b, c, d);
-                }
+                for (int dv = 0; dv < h; dv++)
+                    for (int du = 0; du < w; du++)
+                        mask[u + du + (v + dv) * nu] = FaceKey{};
 
-                // -X
-                if (!is_blocked(chunk, x - 1, y, z, chunks)) {
-                    float l = 0.85f;
-                    auto a = makeV(x - 0.5f, y - 0.5f, z - 0.5f, u, v, l);
-                    auto b = makeV(x - 0.5f, y - 0.5f, z + 0.5f, u + UVSIZE, v, l);
-                    auto c = makeV(x - 0.5f, y + 0.5f, z + 0.5f, u + UVSIZE, v + UVSIZE, l);
-                    auto d = makeV(x - 0.5f, y + 0.5f, z - 0.5f, u, v + UVSIZE, l);
-                    push_face(verts, a, b, c, d);
-                }
+                glm::ivec3 pos;
+                pos[dir.axis] = slice;
+                pos[dir.u_axis] = u;
+                pos[dir.v_axis] = v;
 
-                // +Z
-                if (!is_blocked(chunk, x, y, z + 1, chunks)) {
-                    float l = 0.9f;
-                    auto a = makeV(x - 0.5f, y - 0.5f, z + 0.5f, u, v, l);
-                    auto b = makeV(x + 0.5f, y - 0.5f, z + 0.5f, u + UVSIZE, v, l);
-                    auto c = makeV(x + 0.5f, y + 0.5f, z + 0.5f, u + UVSIZE, v + UVSIZE, l);
-                    auto d = makeV(x - 0.5f, y + 0.5f, z + 0.5f, u, v + UVSIZE, l);
-                    push_face(verts, a, b, c, d);
-                }
+                glm::ivec3 size{ 1, 1, 1 };
+                size[dir.u_axis] = w;
+                size[dir.v_axis] = h;
 
-                // -Z
-                if (!is_blocked(chunk, x, y, z - 1, chunks)) {
-                    float l = 0.8f;
-                    auto a = makeV(x - 0.5f, y - 0.5f, z - 0.5f, u + UVSIZE, v, l);
-                    auto b = makeV(x + 0.5f, y - 0.5f, z - 0.5f, u, v, l);
-                    auto c = makeV(x + 0.5f, y + 0.5f, z - 0.5f, u, v + UVSIZE, l);
-                    auto d = makeV(x - 0.5f, y + 0.5f, z - 0.5f, u + UVSIZE, v + UVSIZE, l);
-                    push_face(verts, a, b, c, d);
-                }
+                push_quad(verts, dir, key.id, key.light, pos.x, pos.y, pos.z, size.x, size.y, size.z);
+                u += w;
             }
-    
-    static BufferLayout chunk_layout = {
-        { ShaderDataType::Float3 }, // pos
-        { ShaderDataType::Float2 }, // uv
-        { ShaderDataType::Float }, // light
-    };
+    }
+}
+
+
+template <typename ChunkT>
+static ChunkMeshData mesh_scratch(MeshScratch<ChunkT>& scratch, VoxelMesher::EMode mode)
+{
+    ChunkMeshData data;
 
-    auto VBO = std::make_shared<VertexBuffer>(
-        verts.data(),
-        verts.size() * sizeof(ChunkVertex),
-        chunk_layout,
-        VertexBuffer::EUsage::Static
-    );
+    const std::size_t face_count = compute_faces(scratch);
+    if (face_count == 0) return data;
+
+    std::vector<FaceKey> mask;
+    if (mode == VoxelMesher::EMode::Naive)
+        data.vertices.reserve(face_count * 4);
+
+    // One direction after the other, in ChunkFace order.
+    for (int d = 0; d < 6; d++)
+    {
+        const std::size_t first = data.vertices.size();
+        if (mode == VoxelMesher::EMode::Greedy)
+            build_greedy(scratch, d, mask, data.vertices);
+        else
+            build_naive(scratch, d, data.vertices);
+        data.face_vertex_counts[static_cast<std::size_t>(FACE_DIRS[d].face)] = static_cast<std::uint32_t>(data.vertices.size() - first);
+    }
+
+    return data;
+}
+
+template <typename ChunkT, int Factor>
+static ChunkMeshData build_coarse(const BasicChunkNeighbourhood<ChunkT>& chunks, MeshScratch<ChunkT>& fine, VoxelMesher::EMode mode)
+{
+    thread_local MeshScratch<CoarseChunk<ChunkT, Factor>> scratch;
+    fill_coarse_scratch<ChunkT, Factor>(chunks, fine, scratch);
+    return mesh_scratch(scratch, mode);
+}
+
+template <typename ChunkT>
+ChunkMeshData VoxelMesher::build_mesh_data(const BasicChunkNeighbourhood<ChunkT>& chunks, EMode mode, int lod)
+{
+    // Corners are packed into 9 bits per axis.
+    static_assert(ChunkT::CHUNK_X < 512 && ChunkT::CHUNK_Y < 512 && ChunkT::CHUNK_Z < 512, "chunk too large for ChunkVertex");
+
+    // Per thread scratch, so meshing from workers doesn't allocate or share it.
+    thread_local MeshScratch<ChunkT> scratch;
+
+    switch (lod)
+    {
+    case 0: break;
+    case 1: return build_coarse<ChunkT, 2>(chunks, scratch, mode);
+    case 2: return build_coarse<ChunkT, 4>(chunks, scratch, mode);
+    default: return build_coarse<ChunkT, 8>(chunks, scratch, mode);
+    }
+
+    fill_scratch(chunks, scratch);
+    return mesh_scratch(scratch, mode);
+}
 
-    return std::make_shared<Mesh>(VBO, verts.size());
-}
\ No newline at end of file
+#define VOXEL_INSTANTIATE_MESHER(x, y, z, layout) \
+    template ChunkMeshData VoxelMesher::build_mesh_data(const BasicChunkNeighbourhood<BasicChunk<x, y, z, layout>>&, EMode, int);
+VOXEL_CHUNK_CONFIGS(VOXEL_INSTANTIATE_MESHER)
@@ -1,16 +1,30 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
-#include <Object/Mesh.hpp>
+#include <Render/ChunkMeshData.hpp>
 #include <Voxel/Chunk.hpp>
+#include <Voxel/ChunkNeighbourhood.hpp>
 
 
 
 class VoxelMesher
 {
 public:
+	enum class EMode
+	{
+		Naive,  // one quad per exposed voxel face
+		Greedy  // coplanar faces with equal id and light merged into rectangles
+	};
+
 	VoxelMesher() = delete;
 
-	static std::shared_ptr<Mesh> build_mesh(std::shared_ptr<Chunk> chunk, const std::vector<std::shared_ptr<Chunk>>& chunks);
+	// CPU only and safe to call from worker threads; upload the result with ChunkRenderer.
+	// Defined for the chunk configurations in VOXEL_CHUNK_CONFIGS. Level lod (below
+	// CHUNK_LOD_COUNT) meshes the chunk downsampled by 2^lod, with corners in coarse
+	// voxels; it never hides a face another level of a neighbour would leave open.
+	template <typename ChunkT>
+	static ChunkMeshData build_mesh_data(const BasicChunkNeighbourhood<ChunkT>& neighbourhood, EMode mode = EMode::Naive,
+										 int lod = 0);
 };
\ No newline at end of file
@@ -1,43 +1,57 @@
 ﻿#include "Chunk.hpp"
 
-#include <iostream>
-#include <cmath>
 
-static inline size_t idx(int x, int y, int z) {
-	return static_cast<size_t>((x + Chunk::CHUNK_X * (y + Chunk::CHUNK_Y * z)));
-}
-
-Chunk::Chunk()
+template <std::size_t SizeX, std::size_t SizeY, std::size_t SizeZ, EChunkLayout Layout>
+BasicChunk<SizeX, SizeY, SizeZ, Layout>::BasicChunk(const std::uint16_t* ids)
 {
-	for (int y = 0; y < CHUNK_Y; y++) {
-		for (int z = 0; z < CHUNK_Z; z++) {
-			for (int x = 0; x < CHUNK_X; x++) {
-
-				int new_x = (x - CHUNK_X / 2);
-				int new_y = (y - CHUNK_X / 2);
-				int new_z = (z - CHUNK_X / 2);
+	// ids is in occupancy order already.
+	for (std::size_t i = 0; i < CHUNK_VOLUME; i++)
+		m_solid[i >> 6] |= std::uint64_t{ ids[i] != 0 } << (i & 63);
 
-				if (sqrt(new_x * new_x + new_y * new_y + new_z * new_z) < CHUNK_X / 2)
-				{
-					voxels[x + CHUNK_X * (y + CHUNK_Y * z)].id = 1;
-				}
-
-			}
-		}
+	if constexpr (Layout == EChunkLayout::Linear) {
+		m_storage.assign(ids);
+	}
+	else {
+		thread_local std::uint16_t ordered[CHUNK_VOLUME];
+		for (int z = 0; z < int(CHUNK_Z); z++)
+			for (int y = 0; y < int(CHUNK_Y); y++)
+				for (int x = 0; x < int(CHUNK_X); x++)
+					ordered[index(x, y, z)] = *ids++;
+		m_storage.assign(ordered);
 	}
 }
 
-std::uint16_t Chunk::get_id(int x, int y, int z) const
+template <std::size_t SizeX, std::size_t SizeY, std::size_t SizeZ, EChunkLayout Layout>
+std::uint16_t BasicChunk<SizeX, SizeY, SizeZ, Layout>::get_id(int x, int y, int z) const
 {
-	if (x < 0 || y < 0 || z < 0 || x >= CHUNK_X || y >= CHUNK_Y || z >= CHUNK_Z) return 0;
-	return voxels[idx(x, y, z)].id;
+	if (!in_bounds(x, y, z)) return 0;
+	return m_storage.get(index(x, y, z));
 
 }
 
-bool Chunk::set_id(int x, int y, int z, std::uint16_t id)
+template <std::size_t SizeX, std::size_t SizeY, std::size_t SizeZ, EChunkLayout Layout>
+std::vector<Voxel> BasicChunk<SizeX, SizeY, SizeZ, Layout>::get_voxels() const
 {
-	if (x < 0 || y < 0 || z < 0 || x >= CHUNK_X || y >= CHUNK_Y || z >= CHUNK_Z) return false;
+	std::vector<Voxel> voxels(CHUNK_VOLUME);
+	for_each_voxel([&](int x, int y, int z, std::uint16_t id) {
+		voxels[x + CHUNK_X * (y + CHUNK_Y * z)].id = id;
+	});
+	return voxels;
+}
+
+template <std::size_t SizeX, std::size_t SizeY, std::size_t SizeZ, EChunkLayout Layout>
+bool BasicChunk<SizeX, SizeY, SizeZ, Layout>::set_id(int x, int y, int z, std::uint16_t id)
+{
+	if (!in_bounds(x, y, z)) return false;
 
-	voxels[idx(x, y, z)].id = id;
+	const auto i = index(x, y, z);
+	if (m_storage.get(i) == id) return true;
+
+	m_storage.set(i, id);
+	set_solid(x, y, z, id != 0);
+	m_dirty = true;
 	return true;
 }
+
+#define VOXEL_INSTANTIATE_CHUNK(x, y, z, layout) template class BasicChunk<x, y, z, layout>;
+VOXEL_CHUNK_CONFIGS(VOXEL_INSTANTIATE_CHUNK)
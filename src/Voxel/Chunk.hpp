@@ -1,31 +1,131 @@
 #pragma once
 
 #include <Voxel/Voxel.hpp>
+#include <Voxel/ChunkLayout.hpp>
+#include <Voxel/PaletteStorage.hpp>
+#include <array>
+#include <bit>
 #include <vector>
 
 #include <glm/vec3.hpp>
 
-class Chunk
+// Chunk of SizeX * SizeY * SizeZ voxels stored in the given layout. Every size is a
+// power of two, so indexing is constant shifts (linear) or bit interleaving (Morton).
+// Next to the ids the chunk keeps one "solid" (id != 0) bit per voxel, in linear order
+// whatever the layout, so a row along X is one machine word read.
+template <std::size_t SizeX, std::size_t SizeY, std::size_t SizeZ, EChunkLayout Layout = EChunkLayout::Linear>
+class BasicChunk
 {
+	static_assert(std::has_single_bit(SizeX) && std::has_single_bit(SizeY) && std::has_single_bit(SizeZ),
+				  "chunk dimensions must be powers of two");
+	static_assert(SizeX <= 64, "a row of the occupancy mask must fit in 64 bits");
+
+	using Indexer = ChunkLayout::Indexer<SizeX, SizeY, SizeZ, Layout>;
+
 public:
-	Chunk();
+	// All air.
+	BasicChunk() = default;
+	// ids holds CHUNK_VOLUME entries, x fastest, then y, then z, whatever the layout.
+	explicit BasicChunk(const std::uint16_t* ids);
 
 	std::uint16_t get_id(int x, int y, int z) const;
-	const std::vector<Voxel>& get_voxels() { return voxels; }
+	// In linear order, like the constructor's ids.
+	std::vector<Voxel> get_voxels() const;
 	bool set_id(int x, int y, int z, std::uint16_t id);
 
+	// fn(int x, int y, int z, std::uint16_t id) for every voxel, in storage order.
+	template <typename F>
+	void for_each_voxel(F&& fn) const
+	{
+		int x, y, z;
+		for (std::size_t i = 0; i < CHUNK_VOLUME; i++) {
+			Indexer::decode(i, x, y, z);
+			fn(x, y, z, m_storage.get(i));
+		}
+	}
+
+	// Occupancy, false outside the chunk.
+	bool is_solid(int x, int y, int z) const
+	{
+		if (!in_bounds(x, y, z)) return false;
+		const std::size_t bit = occupancy_bit(x, y, z);
+		return (m_solid[bit >> 6] >> (bit & 63)) & 1;
+	}
+
+	// Bit x set when voxel (x, y, z) is solid. y and z must be in range.
+	std::uint64_t get_solid_row(int y, int z) const
+	{
+		const std::size_t bit = occupancy_bit(0, y, z);
+		return (m_solid[bit >> 6] >> (bit & 63)) & ROW_MASK;
+	}
+
+	// Set by set_id when a voxel actually changes; cleared once the chunk is remeshed.
+	bool is_dirty() const { return m_dirty; }
+	void mark_dirty() { m_dirty = true; }
+	void clear_dirty() { m_dirty = false; }
+
+	void compact() { m_storage.compact(); }
+	std::size_t get_memory_usage() const { return sizeof(*this) - sizeof(m_storage) + m_storage.get_memory_usage(); }
+
+	static constexpr bool in_bounds(int x, int y, int z)
+	{
+		return x >= 0 && y >= 0 && z >= 0 && x < int(CHUNK_X) && y < int(CHUNK_Y) && z < int(CHUNK_Z);
+	}
+
+	// Storage index of a voxel.
+	static constexpr std::size_t index(int x, int y, int z) { return Indexer::encode(x, y, z); }
+
 
 
 public:
-	static constexpr std::size_t CHUNK_X = 16;
-	static constexpr std::size_t CHUNK_Y = 16;
-	static constexpr std::size_t CHUNK_Z = 16;
+	static constexpr std::size_t CHUNK_X = SizeX;
+	static constexpr std::size_t CHUNK_Y = SizeY;
+	static constexpr std::size_t CHUNK_Z = SizeZ;
 	static constexpr std::size_t CHUNK_VOLUME = CHUNK_X * CHUNK_Y * CHUNK_Z;
+	static constexpr EChunkLayout LAYOUT = Layout;
+	static constexpr std::uint64_t ROW_MASK = SizeX == 64 ? ~0ull : (1ull << SizeX) - 1;
 
 	glm::ivec3 m_pos;
 
 private:
-	std::vector<Voxel> voxels{ CHUNK_VOLUME };
+	static constexpr std::size_t occupancy_bit(int x, int y, int z) { return x + CHUNK_X * (y + CHUNK_Y * z); }
+
+	void set_solid(int x, int y, int z, bool solid)
+	{
+		const std::size_t bit = occupancy_bit(x, y, z);
+		if (solid) m_solid[bit >> 6] |= 1ull << (bit & 63);
+		else m_solid[bit >> 6] &= ~(1ull << (bit & 63));
+	}
+
+	PaletteStorage m_storage{ CHUNK_VOLUME };
+	std::array<std::uint64_t, (CHUNK_VOLUME + 63) / 64> m_solid{};
+	bool m_dirty = false;
+
+
+};
+
+// Configurations compiled into VoxelCore. The game runs on Chunk; the others exist
+// so the benchmark can compare them. Template code over chunk types is explicitly
+// instantiated for this list only.
+#define VOXEL_CHUNK_CONFIGS(X)                \
+	X(16, 16, 16, EChunkLayout::Linear)       \
+	X(32, 32, 32, EChunkLayout::Linear)       \
+	X(16, 256, 16, EChunkLayout::Linear)      \
+	X(16, 16, 16, EChunkLayout::Morton)       \
+	X(32, 32, 32, EChunkLayout::Morton)       \
+	X(16, 256, 16, EChunkLayout::Morton)
+
+#define VOXEL_EXTERN_CHUNK(x, y, z, layout) extern template class BasicChunk<x, y, z, layout>;
+VOXEL_CHUNK_CONFIGS(VOXEL_EXTERN_CHUNK)
+#undef VOXEL_EXTERN_CHUNK
 
+// Set by the VOXEL_MORTON_CHUNKS CMake option.
+#if defined(VOXEL_MORTON_CHUNKS)
+inline constexpr EChunkLayout DEFAULT_CHUNK_LAYOUT = EChunkLayout::Morton;
+#else
+inline constexpr EChunkLayout DEFAULT_CHUNK_LAYOUT = EChunkLayout::Linear;
+#endif
 
-};
\ No newline at end of file
+using Chunk = BasicChunk<16, 16, 16, DEFAULT_CHUNK_LAYOUT>;
+using Chunk32 = BasicChunk<32, 32, 32, DEFAULT_CHUNK_LAYOUT>;
+using ChunkColumn = BasicChunk<16, 256, 16, DEFAULT_CHUNK_LAYOUT>;
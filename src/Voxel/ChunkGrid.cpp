@@ -0,0 +1,56 @@
+#include "ChunkGrid.hpp"
+
+
+template <typename ChunkT>
+void BasicChunkGrid<ChunkT>::add_chunk(glm::ivec3 pos, std::shared_ptr<ChunkT> chunk)
+{
+	chunk->m_pos = pos;
+
+	// Insert first: growing the map would invalidate the neighbour pointers below.
+	auto& own = m_neighbourhoods[pos];
+	own = Neighbourhood{};
+
+	for (int dy = -1; dy <= 1; dy++)
+		for (int dz = -1; dz <= 1; dz++)
+			for (int dx = -1; dx <= 1; dx++) {
+				if (dx == 0 && dy == 0 && dz == 0) continue;
+
+				if (auto* other = m_neighbourhoods.find(pos + glm::ivec3(dx, dy, dz))) {
+					own.chunks[Neighbourhood::index(dx, dy, dz)] = other->center();
+					other->chunks[Neighbourhood::index(-dx, -dy, -dz)] = chunk;
+				}
+			}
+
+	own.chunks[Neighbourhood::CENTER] = std::move(chunk);
+}
+
+template <typename ChunkT>
+void BasicChunkGrid<ChunkT>::remove_chunk(glm::ivec3 pos)
+{
+	if (!m_neighbourhoods.erase(pos)) return;
+
+	for (int dy = -1; dy <= 1; dy++)
+		for (int dz = -1; dz <= 1; dz++)
+			for (int dx = -1; dx <= 1; dx++)
+				if (auto* other = m_neighbourhoods.find(pos + glm::ivec3(dx, dy, dz)))
+					other->chunks[Neighbourhood::index(-dx, -dy, -dz)] = nullptr;
+}
+
+template <typename ChunkT>
+std::shared_ptr<ChunkT> BasicChunkGrid<ChunkT>::get_chunk(glm::ivec3 pos) const
+{
+	const auto* neighbourhood = m_neighbourhoods.find(pos);
+	return neighbourhood ? neighbourhood->center() : nullptr;
+}
+
+template <typename ChunkT>
+const typename BasicChunkGrid<ChunkT>::Neighbourhood& BasicChunkGrid<ChunkT>::get_neighbourhood(glm::ivec3 pos) const
+{
+	static const Neighbourhood empty{};
+
+	const auto* neighbourhood = m_neighbourhoods.find(pos);
+	return neighbourhood ? *neighbourhood : empty;
+}
+
+#define VOXEL_INSTANTIATE_CHUNK_GRID(x, y, z, layout) template class BasicChunkGrid<BasicChunk<x, y, z, layout>>;
+VOXEL_CHUNK_CONFIGS(VOXEL_INSTANTIATE_CHUNK_GRID)
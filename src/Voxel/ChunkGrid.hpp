@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+
+#include <glm/vec3.hpp>
+
+#include <Voxel/Chunk.hpp>
+#include <Voxel/ChunkMap.hpp>
+#include <Voxel/ChunkNeighbourhood.hpp>
+
+// Sparse set of chunks addressed by signed chunk coordinates. Every chunk caches its
+// neighbourhood, kept up to date in O(1) as chunks are added and removed.
+template <typename ChunkT>
+class BasicChunkGrid
+{
+public:
+	using Neighbourhood = BasicChunkNeighbourhood<ChunkT>;
+
+	void add_chunk(glm::ivec3 pos, std::shared_ptr<ChunkT> chunk);
+	void remove_chunk(glm::ivec3 pos);
+
+	std::shared_ptr<ChunkT> get_chunk(glm::ivec3 pos) const;
+	// Neighbourhood of the chunk at pos, all null if there is none.
+	const Neighbourhood& get_neighbourhood(glm::ivec3 pos) const;
+
+	bool contains(glm::ivec3 pos) const { return m_neighbourhoods.contains(pos); }
+	std::size_t get_chunk_count() const { return m_neighbourhoods.size(); }
+	void reserve(std::size_t chunk_count) { m_neighbourhoods.reserve(chunk_count); }
+
+	// fn(const std::shared_ptr<ChunkT>&) for every chunk.
+	template <typename F>
+	void for_each_chunk(F&& fn) const
+	{
+		m_neighbourhoods.for_each([&](glm::ivec3, const Neighbourhood& neighbourhood) { fn(neighbourhood.center()); });
+	}
+
+private:
+	ChunkMap<Neighbourhood> m_neighbourhoods;
+};
+
+#define VOXEL_EXTERN_CHUNK_GRID(x, y, z, layout) extern template class BasicChunkGrid<BasicChunk<x, y, z, layout>>;
+VOXEL_CHUNK_CONFIGS(VOXEL_EXTERN_CHUNK_GRID)
+#undef VOXEL_EXTERN_CHUNK_GRID
+
+using ChunkGrid = BasicChunkGrid<Chunk>;
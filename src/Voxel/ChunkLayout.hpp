@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// Order of the voxels of a chunk in storage.
+enum class EChunkLayout
+{
+	Linear, // x + X * (y + Y * z)
+	Morton  // bits of x, y and z interleaved (Z-order), so neighbours on every axis tend to share cache lines
+};
+
+namespace ChunkLayout
+{
+	// Portable PDEP / PEXT: scatter the low bits of value to the set bits of mask, and back.
+	constexpr std::uint32_t deposit(std::uint32_t value, std::uint32_t mask)
+	{
+		std::uint32_t result = 0;
+		for (std::uint32_t bit = 1; mask; bit <<= 1, mask &= mask - 1)
+			if (value & bit) result |= mask & (~mask + 1);
+		return result;
+	}
+
+	constexpr std::uint32_t extract(std::uint32_t value, std::uint32_t mask)
+	{
+		std::uint32_t result = 0;
+		for (std::uint32_t bit = 1; mask; bit <<= 1, mask &= mask - 1)
+			if (value & mask & (~mask + 1)) result |= bit;
+		return result;
+	}
+
+	// Index bits owned by each axis. Axes take turns x, y, z from the lowest bit; once
+	// the shorter axes run out the longer ones continue alone, so 16x256x16 is a column
+	// of 16^3 Morton blocks.
+	constexpr std::array<std::uint32_t, 3> morton_masks(int bits_x, int bits_y, int bits_z)
+	{
+		const int bits[3] = { bits_x, bits_y, bits_z };
+		std::array<std::uint32_t, 3> masks{};
+		int out = 0;
+		for (int round = 0; round < 32; round++)
+			for (int axis = 0; axis < 3; axis++)
+				if (round < bits[axis]) masks[axis] |= 1u << out++;
+		return masks;
+	}
+
+	template <std::size_t X, std::size_t Y, std::size_t Z, EChunkLayout Layout>
+	struct Indexer;
+
+	template <std::size_t X, std::size_t Y, std::size_t Z>
+	struct Indexer<X, Y, Z, EChunkLayout::Linear>
+	{
+		static constexpr int SHIFT_Y = std::countr_zero(X);
+		static constexpr int SHIFT_Z = std::countr_zero(X * Y);
+
+		static constexpr std::size_t encode(int x, int y, int z)
+		{
+			return static_cast<std::size_t>(x) | static_cast<std::size_t>(y) << SHIFT_Y | static_cast<std::size_t>(z) << SHIFT_Z;
+		}
+
+		static constexpr void decode(std::size_t index, int& x, int& y, int& z)
+		{
+			x = static_cast<int>(index & (X - 1));
+			y = static_cast<int>((index >> SHIFT_Y) & (Y - 1));
+			z = static_cast<int>(index >> SHIFT_Z);
+		}
+	};
+
+	// Encodes with BMI2 when the build targets it, otherwise with one small table per
+	// axis (PDEP is microcoded on older AMD cores, the tables are fast everywhere).
+	// Decoding without BMI2 looks up each byte of the index, the bytes own disjoint
+	// coordinate bits so the partial results just add up.
+	template <std::size_t X, std::size_t Y, std::size_t Z>
+	struct Indexer<X, Y, Z, EChunkLayout::Morton>
+	{
+		static_assert(X <= 1024 && Y <= 1024 && Z <= 1024 && X * Y * Z <= (1u << 24), "chunk too large for the Morton tables");
+
+		static constexpr std::array<std::uint32_t, 3> MASKS = morton_masks(std::countr_zero(X), std::countr_zero(Y), std::countr_zero(Z));
+
+		template <std::size_t N>
+		static constexpr std::array<std::uint32_t, N> make_table(std::uint32_t mask)
+		{
+			std::array<std::uint32_t, N> table{};
+			for (std::uint32_t i = 0; i < N; i++) table[i] = deposit(i, mask);
+			return table;
+		}
+
+		// Entry b of byte k: the coordinates encoded by b << 8k, as x | y << 10 | z << 20.
+		static constexpr std::array<std::array<std::uint32_t, 256>, 3> make_decode_tables()
+		{
+			std::array<std::array<std::uint32_t, 256>, 3> tables{};
+			for (std::uint32_t k = 0; k < 3; k++)
+				for (std::uint32_t b = 0; b < 256; b++) {
+					const std::uint32_t i = b << (8 * k);
+					tables[k][b] = extract(i, MASKS[0]) | extract(i, MASKS[1]) << 10 | extract(i, MASKS[2]) << 20;
+				}
+			return tables;
+		}
+
+		static constexpr std::array<std::uint32_t, X> TABLE_X = make_table<X>(MASKS[0]);
+		static constexpr std::array<std::uint32_t, Y> TABLE_Y = make_table<Y>(MASKS[1]);
+		static constexpr std::array<std::uint32_t, Z> TABLE_Z = make_table<Z>(MASKS[2]);
+		static constexpr std::array<std::array<std::uint32_t, 256>, 3> DECODE = make_decode_tables();
+
+		static constexpr std::size_t encode(int x, int y, int z)
+		{
+#if defined(__BMI2__)
+			if (!std::is_constant_evaluated())
+				return _pdep_u32(x, MASKS[0]) | _pdep_u32(y, MASKS[1]) | _pdep_u32(z, MASKS[2]);
+#endif
+			return TABLE_X[x] | TABLE_Y[y] | TABLE_Z[z];
+		}
+
+		static constexpr void decode(std::size_t index, int& x, int& y, int& z)
+		{
+			const auto i = static_cast<std::uint32_t>(index);
+#if defined(__BMI2__)
+			if (!std::is_constant_evaluated()) {
+				x = static_cast<int>(_pext_u32(i, MASKS[0]));
+				y = static_cast<int>(_pext_u32(i, MASKS[1]));
+				z = static_cast<int>(_pext_u32(i, MASKS[2]));
+				return;
+			}
+#endif
+			const std::uint32_t xyz = DECODE[0][i & 0xff] + DECODE[1][(i >> 8) & 0xff] + DECODE[2][(i >> 16) & 0xff];
+			x = static_cast<int>(xyz & 0x3ff);
+			y = static_cast<int>((xyz >> 10) & 0x3ff);
+			z = static_cast<int>(xyz >> 20);
+		}
+	};
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+// Open-addressing hash map keyed by signed chunk coordinates. Keys are packed into
+// 64 bits (21 bits per axis, so -2^20..2^20-1 chunks), probing is linear and erase
+// shifts the following entries back rather than leaving tombstones.
+// Growing the table invalidates references to values.
+template <typename T>
+class ChunkMap
+{
+public:
+	static constexpr int AXIS_BITS = 21;
+	static constexpr int COORD_MIN = -(1 << (AXIS_BITS - 1));
+	static constexpr int COORD_MAX = (1 << (AXIS_BITS - 1)) - 1;
+
+	static std::uint64_t pack(glm::ivec3 pos)
+	{
+		return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.x)) & AXIS_MASK)
+			| (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.y)) & AXIS_MASK) << AXIS_BITS
+			| (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.z)) & AXIS_MASK) << (2 * AXIS_BITS);
+	}
+
+	static glm::ivec3 unpack(std::uint64_t key)
+	{
+		const auto axis = [](std::uint64_t bits) {
+			constexpr int sign = 1 << (AXIS_BITS - 1);
+			return (static_cast<int>(bits & AXIS_MASK) ^ sign) - sign;
+		};
+		return { axis(key), axis(key >> AXIS_BITS), axis(key >> (2 * AXIS_BITS)) };
+	}
+
+	T* find(glm::ivec3 pos)
+	{
+		if (m_slots.empty()) return nullptr;
+		Slot& slot = m_slots[probe(pack(pos))];
+		return slot.key == EMPTY ? nullptr : &slot.value;
+	}
+
+	const T* find(glm::ivec3 pos) const { return const_cast<ChunkMap*>(this)->find(pos); }
+	bool contains(glm::ivec3 pos) const { return find(pos) != nullptr; }
+
+	// Default-constructs the value if pos is not in the map yet.
+	T& operator[](glm::ivec3 pos)
+	{
+		if ((m_size + 1) * 4 > m_slots.size() * 3)
+			rehash(m_slots.empty() ? MIN_CAPACITY : m_slots.size() * 2);
+
+		const std::uint64_t key = pack(pos);
+		Slot& slot = m_slots[probe(key)];
+		if (slot.key == EMPTY) {
+			slot.key = key;
+			m_size++;
+		}
+		return slot.value;
+	}
+
+	bool erase(glm::ivec3 pos)
+	{
+		if (m_slots.empty()) return false;
+
+		std::size_t hole = probe(pack(pos));
+		if (m_slots[hole].key == EMPTY) return false;
+
+		// Pull back every following entry of the cluster that may live in the hole.
+		const std::size_t mask = m_slots.size() - 1;
+		for (std::size_t next = (hole + 1) & mask; m_slots[next].key != EMPTY; next = (next + 1) & mask) {
+			const std::size_t home = hash(m_slots[next].key) & mask;
+			if (((next - home) & mask) >= ((next - hole) & mask)) {
+				m_slots[hole] = std::move(m_slots[next]);
+				hole = next;
+			}
+		}
+		m_slots[hole] = Slot{};
+		m_size--;
+		return true;
+	}
+
+	void clear()
+	{
+		m_slots.clear();
+		m_size = 0;
+	}
+
+	void reserve(std::size_t count)
+	{
+		std::size_t capacity = MIN_CAPACITY;
+		while (count * 4 > capacity * 3) capacity *= 2;
+		if (capacity > m_slots.size()) rehash(capacity);
+	}
+
+	std::size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+
+	// fn(glm::ivec3 pos, T& value) for every entry, in table order.
+	template <typename F>
+	void for_each(F&& fn)
+	{
+		for (auto& slot : m_slots)
+			if (slot.key != EMPTY) fn(unpack(slot.key), slot.value);
+	}
+
+	template <typename F>
+	void for_each(F&& fn) const
+	{
+		for (const auto& slot : m_slots)
+			if (slot.key != EMPTY) fn(unpack(slot.key), slot.value);
+	}
+
+private:
+	static constexpr std::uint64_t AXIS_MASK = (1ull << AXIS_BITS) - 1;
+	static constexpr std::uint64_t EMPTY = ~0ull; // pack never sets bit 63
+	static constexpr std::size_t MIN_CAPACITY = 64;
+
+	struct Slot
+	{
+		std::uint64_t key = EMPTY;
+		T value{};
+	};
+
+	// splitmix64 finaliser, neighbouring coordinates land far apart.
+	static std::size_t hash(std::uint64_t key)
+	{
+		key ^= key >> 30;
+		key *= 0xbf58476d1ce4e5b9ull;
+		key ^= key >> 27;
+		key *= 0x94d049bb133111ebull;
+		key ^= key >> 31;
+		return static_cast<std::size_t>(key);
+	}
+
+	// Slot holding key, or the empty slot where it would be inserted.
+	std::size_t probe(std::uint64_t key) const
+	{
+		const std::size_t mask = m_slots.size() - 1;
+		std::size_t i = hash(key) & mask;
+		while (m_slots[i].key != EMPTY && m_slots[i].key != key)
+			i = (i + 1) & mask;
+		return i;
+	}
+
+	void rehash(std::size_t capacity)
+	{
+		std::vector<Slot> old = std::exchange(m_slots, std::vector<Slot>(capacity));
+		for (auto& slot : old)
+			if (slot.key != EMPTY) m_slots[probe(slot.key)] = std::move(slot);
+	}
+
+	std::vector<Slot> m_slots; // power-of-two size
+	std::size_t m_size = 0;
+};
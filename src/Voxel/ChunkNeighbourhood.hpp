@@ -0,0 +1,26 @@
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include <Voxel/Chunk.hpp>
+
+// A chunk and the 26 chunks around it. Missing neighbours (world edge, not loaded) are null.
+template <typename ChunkT>
+struct BasicChunkNeighbourhood
+{
+	using chunk_type = ChunkT;
+
+	static constexpr int SIZE = 27;
+
+	// X fastest, then Z, then Y; offsets are -1..1 on each axis.
+	static constexpr int index(int dx, int dy, int dz) { return (dx + 1) + 3 * (dz + 1) + 9 * (dy + 1); }
+	static constexpr int CENTER = 13; // index(0, 0, 0)
+
+	const std::shared_ptr<ChunkT>& get(int dx, int dy, int dz) const { return chunks[index(dx, dy, dz)]; }
+	const std::shared_ptr<ChunkT>& center() const { return chunks[CENTER]; }
+
+	std::array<std::shared_ptr<ChunkT>, SIZE> chunks;
+};
+
+using ChunkNeighbourhood = BasicChunkNeighbourhood<Chunk>;
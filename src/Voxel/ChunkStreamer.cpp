@@ -0,0 +1,217 @@
+#include "ChunkStreamer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <common/ThreadPool.hpp>
+
+
+static constexpr glm::ivec3 FACE_OFFSETS[6] = {
+	{ 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+};
+
+static const glm::vec3 CHUNK_SIZE = { Chunk::CHUNK_X, Chunk::CHUNK_Y, Chunk::CHUNK_Z };
+
+static inline bool in_radius(glm::ivec3 pos, glm::ivec3 center, int radius)
+{
+	const glm::ivec3 d = pos - center;
+	return d.x * d.x + d.y * d.y + d.z * d.z <= radius * radius;
+}
+
+
+ChunkStreamer::ChunkStreamer(World& world)
+	: ChunkStreamer(world, Settings{})
+{
+}
+
+ChunkStreamer::ChunkStreamer(World& world, const Settings& settings)
+	: m_world(world),
+	  m_settings(settings)
+{
+}
+
+void ChunkStreamer::set_settings(const Settings& settings)
+{
+	m_settings = settings;
+	m_center.reset(); // radii may have changed
+
+	while (m_cache.size() > m_settings.cache_capacity) {
+		m_cache_index.erase(m_cache.back().first);
+		m_cache.pop_back();
+	}
+}
+
+void ChunkStreamer::update(glm::vec3 camera_position, glm::vec3 camera_direction)
+{
+	m_camera_position = camera_position;
+	m_camera_direction = camera_direction;
+
+	// Voxel centres sit on integer coordinates, so chunk c spans c * CHUNK - 0.5 .. (c + 1) * CHUNK - 0.5.
+	const glm::vec3 cell = glm::floor((camera_position + 0.5f) / CHUNK_SIZE);
+	const glm::ivec3 center = { static_cast<int>(cell.x), static_cast<int>(cell.y), static_cast<int>(cell.z) };
+	if (!m_center || *m_center != center)
+		rescan(center);
+
+	generate_pending();
+	mesh_pending();
+
+	m_stats.cached = m_cache.size();
+	m_stats.pending_generate = m_to_generate.size();
+	m_stats.pending_mesh = m_to_mesh.size();
+	m_stats.loaded = m_world.get_grid().get_chunk_count();
+}
+
+// Unloads chunks that fell out of range and lists the ones that came into it.
+void ChunkStreamer::rescan(glm::ivec3 center)
+{
+	m_center = center;
+	const int radius = m_settings.render_radius;
+
+	std::vector<glm::ivec3> out_of_range;
+	m_world.get_grid().for_each_chunk([&](const std::shared_ptr<Chunk>& chunk) {
+		if (!in_radius(chunk->m_pos, center, radius + m_settings.unload_margin))
+			out_of_range.push_back(chunk->m_pos);
+	});
+	for (const auto& pos : out_of_range)
+		unload(pos);
+
+	m_to_generate.clear();
+	for (int dy = -radius; dy <= radius; dy++)
+		for (int dz = -radius; dz <= radius; dz++)
+			for (int dx = -radius; dx <= radius; dx++) {
+				const glm::ivec3 pos = center + glm::ivec3(dx, dy, dz);
+				if (in_radius(pos, center, radius) && !m_world.get_grid().contains(pos))
+					m_to_generate.push_back(pos);
+			}
+
+	std::erase_if(m_to_mesh, [&](glm::ivec3 pos) { return !m_world.get_grid().contains(pos); });
+}
+
+void ChunkStreamer::generate_pending()
+{
+	m_stats.generate_seconds = 0.0;
+	if (m_to_generate.empty()) return;
+
+	sort_by_priority(m_to_generate);
+
+	// Cached chunks come back for free; only fresh ones count against the budget.
+	std::vector<glm::ivec3> batch;
+	while (!m_to_generate.empty() && batch.size() < m_settings.generate_budget) {
+		const glm::ivec3 pos = m_to_generate.back();
+		m_to_generate.pop_back();
+
+		if (auto chunk = take_cached(pos)) {
+			m_world.add_chunk(pos, std::move(chunk));
+			m_to_mesh.push_back(pos);
+		}
+		else {
+			batch.push_back(pos);
+		}
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	std::vector<std::shared_ptr<Chunk>> chunks(batch.size());
+	ThreadPool::get().parallel_for(batch.size(), [&](std::size_t i) {
+		chunks[i] = m_world.generate_chunk(batch[i]);
+	});
+	m_stats.generate_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	for (std::size_t i = 0; i < batch.size(); ++i) {
+		m_world.add_chunk(batch[i], std::move(chunks[i]));
+		m_to_mesh.push_back(batch[i]);
+	}
+}
+
+// A chunk is meshed once every face neighbour it will ever have is loaded, so the
+// load front does not mesh each chunk twice.
+void ChunkStreamer::mesh_pending()
+{
+	if (m_to_mesh.empty()) return;
+
+	const auto& grid = m_world.get_grid();
+	const auto ready = [&](glm::ivec3 pos) {
+		for (const auto& offset : FACE_OFFSETS)
+			if (!grid.contains(pos + offset) && in_render_radius(pos + offset))
+				return false;
+		return true;
+	};
+
+	std::vector<glm::ivec3> candidates;
+	std::vector<glm::ivec3> waiting;
+	for (const auto& pos : m_to_mesh)
+		(ready(pos) ? candidates : waiting).push_back(pos);
+
+	sort_by_priority(candidates);
+
+	std::vector<glm::ivec3> batch;
+	while (!candidates.empty() && batch.size() < m_settings.mesh_budget) {
+		batch.push_back(candidates.back());
+		candidates.pop_back();
+	}
+	m_world.mesh_chunks(batch);
+
+	waiting.insert(waiting.end(), candidates.begin(), candidates.end());
+	m_to_mesh = std::move(waiting);
+}
+
+bool ChunkStreamer::in_render_radius(glm::ivec3 pos) const
+{
+	return m_center && in_radius(pos, *m_center, m_settings.render_radius);
+}
+
+// Distance from the camera in chunks, doubled for chunks straight behind it.
+float ChunkStreamer::priority(glm::ivec3 pos) const
+{
+	const glm::vec3 chunk_center = glm::vec3(pos) * CHUNK_SIZE + (CHUNK_SIZE - 1.f) * 0.5f;
+	const glm::vec3 offset = (chunk_center - m_camera_position) / CHUNK_SIZE;
+
+	const float distance = glm::length(offset);
+	if (distance < 1e-3f) return 0.f;
+
+	const float facing = glm::dot(offset / distance, m_camera_direction);
+	return distance * (1.5f - 0.5f * facing);
+}
+
+// Most important last, so batches are taken from the back.
+void ChunkStreamer::sort_by_priority(std::vector<glm::ivec3>& positions) const
+{
+	std::vector<std::pair<float, glm::ivec3>> keyed;
+	keyed.reserve(positions.size());
+	for (const auto& pos : positions)
+		keyed.emplace_back(priority(pos), pos);
+
+	std::sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+	for (std::size_t i = 0; i < keyed.size(); ++i)
+		positions[i] = keyed[i].second;
+}
+
+void ChunkStreamer::unload(glm::ivec3 pos)
+{
+	auto chunk = m_world.remove_chunk(pos);
+	if (!chunk || m_settings.cache_capacity == 0) return;
+
+	m_cache.emplace_front(pos, std::move(chunk));
+	m_cache_index[pos] = m_cache.begin();
+
+	if (m_cache.size() > m_settings.cache_capacity) {
+		m_cache_index.erase(m_cache.back().first);
+		m_cache.pop_back();
+	}
+}
+
+std::shared_ptr<Chunk> ChunkStreamer::take_cached(glm::ivec3 pos)
+{
+	const auto* it = m_cache_index.find(pos);
+	if (!it) return nullptr;
+
+	const auto entry = *it;
+	auto chunk = std::move(entry->second);
+	m_cache.erase(entry);
+	m_cache_index.erase(pos);
+	return chunk;
+}
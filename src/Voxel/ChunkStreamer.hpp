@@ -0,0 +1,77 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include <Voxel/Chunk.hpp>
+#include <Voxel/ChunkMap.hpp>
+#include <Voxel/World.hpp>
+
+// Keeps the chunks around the camera generated and meshed. Chunks further than
+// render_radius + unload_margin are unloaded into a bounded LRU cache, so turning
+// back does not regenerate them. Work is capped per update and done nearest and
+// in front of the camera first.
+class ChunkStreamer
+{
+public:
+	struct Settings
+	{
+		int render_radius = 6;             // in chunks
+		int unload_margin = 2;             // hysteresis beyond render_radius
+		std::size_t cache_capacity = 512;  // unloaded chunks kept in memory
+		std::size_t generate_budget = 32;  // chunks generated per update
+		std::size_t mesh_budget = 32;      // chunks meshed per update
+	};
+
+	struct Stats
+	{
+		std::size_t loaded = 0;
+		std::size_t cached = 0;
+		std::size_t pending_generate = 0;
+		std::size_t pending_mesh = 0;
+		double generate_seconds = 0.0; // last update
+	};
+
+	explicit ChunkStreamer(World& world);
+	ChunkStreamer(World& world, const Settings& settings);
+
+	void set_settings(const Settings& settings);
+	const Settings& get_settings() const { return m_settings; }
+
+	void update(glm::vec3 camera_position, glm::vec3 camera_direction);
+
+	const Stats& get_stats() const { return m_stats; }
+
+private:
+	using Cache = std::list<std::pair<glm::ivec3, std::shared_ptr<Chunk>>>;
+
+	void rescan(glm::ivec3 center);
+	void generate_pending();
+	void mesh_pending();
+
+	bool in_render_radius(glm::ivec3 pos) const;
+	float priority(glm::ivec3 pos) const;
+	void sort_by_priority(std::vector<glm::ivec3>& positions) const;
+
+	void unload(glm::ivec3 pos);
+	std::shared_ptr<Chunk> take_cached(glm::ivec3 pos);
+
+	World& m_world;
+	Settings m_settings;
+	Stats m_stats;
+
+	std::optional<glm::ivec3> m_center; // camera chunk at the last rescan
+	glm::vec3 m_camera_position{ 0.f };
+	glm::vec3 m_camera_direction{ 0.f, 0.f, -1.f };
+
+	std::vector<glm::ivec3> m_to_generate;
+	std::vector<glm::ivec3> m_to_mesh;
+
+	Cache m_cache; // most recently unloaded first
+	ChunkMap<Cache::iterator> m_cache_index;
+};
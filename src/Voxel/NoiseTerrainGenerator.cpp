@@ -0,0 +1,84 @@
+#include "NoiseTerrainGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <common/Noise.hpp>
+
+
+// Independent streams for the heightmap and the caves.
+static constexpr std::uint32_t HEIGHT_SEED = 0x68e31da4U;
+static constexpr std::uint32_t CAVE_SEED = 0xb5297a4dU;
+
+
+NoiseTerrainGenerator::NoiseTerrainGenerator()
+	: NoiseTerrainGenerator(Settings{})
+{
+}
+
+NoiseTerrainGenerator::NoiseTerrainGenerator(const Settings& settings)
+	: m_settings(settings)
+{
+}
+
+void NoiseTerrainGenerator::generate(glm::ivec3 origin, glm::ivec3 size, std::uint32_t seed, std::uint16_t* ids) const
+{
+	const auto& s = m_settings;
+	const std::size_t columns = static_cast<std::size_t>(size.x) * size.z;
+	const std::size_t volume = columns * size.y;
+
+	// Per thread scratch, sized for the largest chunk configuration seen so far.
+	thread_local std::vector<float> height_noise;
+	thread_local std::vector<int> heights;
+	height_noise.resize(std::max(height_noise.size(), columns));
+	heights.resize(std::max(heights.size(), columns));
+
+	Noise::fbm2_grid(origin.x, origin.z, size.x, size.z, s.height_frequency,
+					 seed ^ HEIGHT_SEED, s.height_octaves, height_noise.data());
+
+	int max_height = INT32_MIN;
+	for (std::size_t i = 0; i < columns; i++) {
+		heights[i] = static_cast<int>(std::floor(s.base_height + s.height_amplitude * height_noise[i]));
+		max_height = std::max(max_height, heights[i]);
+	}
+
+	// Most chunks of a streamed world are open sky.
+	if (origin.y > max_height) {
+		std::fill(ids, ids + volume, std::uint16_t{ 0 });
+		return;
+	}
+
+	// Cave noise only for the rows that can be under a cave roof, sampled as one block.
+	thread_local std::vector<float> cave_noise;
+	const int cave_rows = std::clamp(max_height - s.cave_roof - origin.y + 1, 0, size.y);
+	if (cave_rows > 0) {
+		cave_noise.resize(std::max(cave_noise.size(), columns * cave_rows));
+		Noise::fbm3_grid(origin.x, origin.y, origin.z, size.x, cave_rows, size.z, s.cave_frequency,
+						 seed ^ CAVE_SEED, s.cave_octaves, cave_noise.data());
+	}
+
+	std::size_t i = 0;
+	for (int z = 0; z < size.z; z++) {
+		for (int y = 0; y < size.y; y++) {
+			const int world_y = origin.y + y;
+			for (int x = 0; x < size.x; x++, i++) {
+				const int depth = heights[x + size.x * z] - world_y;
+				if (depth < 0) {
+					ids[i] = 0;
+					continue;
+				}
+
+				if (depth >= s.cave_roof) {
+					const float cave = cave_noise[x + size.x * (y + cave_rows * z)];
+					if (cave > s.cave_threshold) {
+						ids[i] = 0;
+						continue;
+					}
+				}
+
+				ids[i] = depth == 0 ? s.grass_id : (depth <= s.dirt_depth ? s.dirt_id : s.stone_id);
+			}
+		}
+	}
+}
\ No newline at end of file
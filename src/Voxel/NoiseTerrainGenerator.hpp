@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Voxel/TerrainGenerator.hpp>
+
+// Fractal-noise heightmap with grass over dirt over stone, carved by 3D noise caves.
+class NoiseTerrainGenerator : public TerrainGenerator
+{
+public:
+	struct Settings
+	{
+		float base_height = 24.f;          // voxels
+		float height_amplitude = 32.f;
+		float height_frequency = 1.f / 256.f;
+		int height_octaves = 5;
+
+		float cave_frequency = 1.f / 48.f;
+		int cave_octaves = 2;
+		float cave_threshold = 0.35f;      // noise above this is carved out
+		int cave_roof = 4;                 // solid voxels kept under the surface
+
+		int dirt_depth = 3;
+		std::uint16_t grass_id = 1;
+		std::uint16_t dirt_id = 2;
+		std::uint16_t stone_id = 3;
+	};
+
+	NoiseTerrainGenerator();
+	explicit NoiseTerrainGenerator(const Settings& settings);
+
+	void generate(glm::ivec3 origin, glm::ivec3 size, std::uint32_t seed, std::uint16_t* ids) const override;
+
+	const Settings& get_settings() const { return m_settings; }
+
+private:
+	Settings m_settings;
+};
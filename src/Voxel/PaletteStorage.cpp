@@ -0,0 +1,167 @@
+#include "PaletteStorage.hpp"
+
+#include <algorithm>
+
+
+PaletteStorage::PaletteStorage(std::size_t size, std::uint16_t fill_id)
+	: m_size(size),
+	  m_palette{ fill_id }
+{
+}
+
+std::uint16_t PaletteStorage::get(std::size_t index) const
+{
+	return m_palette[get_index(index)];
+}
+
+void PaletteStorage::set(std::size_t index, std::uint16_t id)
+{
+	if (m_bits == 0 && m_palette[0] == id) return;
+
+	set_index(index, find_or_add(id));
+}
+
+void PaletteStorage::fill(std::uint16_t id)
+{
+	m_palette.assign(1, id);
+	m_palette.shrink_to_fit();
+	m_data.clear();
+	m_data.shrink_to_fit();
+	m_bits = 0;
+}
+
+void PaletteStorage::assign(const std::uint16_t* ids)
+{
+	// Generated data comes in long runs of one id, so remember the last lookup.
+	std::vector<std::uint16_t> palette;
+	std::uint16_t last_id = ids[0];
+	palette.push_back(last_id);
+	for (std::size_t i = 1; i < m_size; i++) {
+		if (ids[i] == last_id) continue;
+		last_id = ids[i];
+		if (std::find(palette.begin(), palette.end(), last_id) == palette.end())
+			palette.push_back(last_id);
+	}
+
+	if (palette.size() == 1) {
+		fill(palette[0]);
+		return;
+	}
+
+	m_palette = std::move(palette);
+	m_palette.shrink_to_fit();
+	m_bits = bits_for(m_palette.size());
+	m_data.assign((m_size * m_bits + 63) / 64, 0);
+	m_data.shrink_to_fit();
+
+	std::uint32_t last_index = 0;
+	last_id = m_palette[0];
+	for (std::size_t i = 0; i < m_size; i++) {
+		if (ids[i] != last_id) {
+			last_id = ids[i];
+			last_index = static_cast<std::uint32_t>(std::find(m_palette.begin(), m_palette.end(), last_id) - m_palette.begin());
+		}
+		if (last_index != 0) set_index(i, last_index);
+	}
+}
+
+void PaletteStorage::compact()
+{
+	if (m_bits == 0) return;
+
+	std::vector<std::uint32_t> remap(m_palette.size(), UINT32_MAX);
+	std::vector<std::uint16_t> palette;
+
+	for (std::size_t i = 0; i < m_size; i++) {
+		auto& mapped = remap[get_index(i)];
+		if (mapped == UINT32_MAX) {
+			mapped = static_cast<std::uint32_t>(palette.size());
+			palette.push_back(m_palette[get_index(i)]);
+		}
+	}
+
+	if (palette.size() == m_palette.size()) return;
+
+	if (palette.size() == 1) {
+		fill(palette[0]);
+		return;
+	}
+
+	std::vector<std::uint32_t> indices(m_size);
+	for (std::size_t i = 0; i < m_size; i++)
+		indices[i] = remap[get_index(i)];
+
+	m_palette = std::move(palette);
+	m_palette.shrink_to_fit();
+	m_bits = bits_for(m_palette.size());
+	m_data.assign((m_size * m_bits + 63) / 64, 0);
+	m_data.shrink_to_fit();
+
+	for (std::size_t i = 0; i < m_size; i++)
+		set_index(i, indices[i]);
+}
+
+std::size_t PaletteStorage::get_memory_usage() const
+{
+	return sizeof(*this) + m_palette.capacity() * sizeof(std::uint16_t) + m_data.capacity() * sizeof(std::uint64_t);
+}
+
+std::uint32_t PaletteStorage::get_index(std::size_t index) const
+{
+	if (m_bits == 0) return 0;
+
+	// Widths are powers of two, so an entry never straddles two words.
+	const std::size_t bit = index * m_bits;
+	const std::uint64_t mask = (std::uint64_t{ 1 } << m_bits) - 1;
+	return static_cast<std::uint32_t>((m_data[bit >> 6] >> (bit & 63)) & mask);
+}
+
+void PaletteStorage::set_index(std::size_t index, std::uint32_t palette_index)
+{
+	const std::size_t bit = index * m_bits;
+	const std::uint64_t mask = (std::uint64_t{ 1 } << m_bits) - 1;
+	std::uint64_t& word = m_data[bit >> 6];
+	word = (word & ~(mask << (bit & 63))) | (std::uint64_t{ palette_index } << (bit & 63));
+}
+
+std::uint32_t PaletteStorage::find_or_add(std::uint16_t id)
+{
+	auto found = std::find(m_palette.begin(), m_palette.end(), id);
+	if (found != m_palette.end())
+		return static_cast<std::uint32_t>(found - m_palette.begin());
+
+	m_palette.push_back(id);
+
+	const unsigned int bits = bits_for(m_palette.size());
+	if (bits != m_bits)
+		repack(bits);
+
+	return static_cast<std::uint32_t>(m_palette.size() - 1);
+}
+
+void PaletteStorage::repack(unsigned int bits)
+{
+	std::vector<std::uint64_t> old_data = std::move(m_data);
+	const unsigned int old_bits = m_bits;
+
+	m_bits = bits;
+	m_data.assign((m_size * m_bits + 63) / 64, 0);
+
+	if (old_bits == 0) return; // every entry was palette index 0
+
+	const std::uint64_t old_mask = (std::uint64_t{ 1 } << old_bits) - 1;
+	for (std::size_t i = 0; i < m_size; i++) {
+		const std::size_t bit = i * old_bits;
+		set_index(i, static_cast<std::uint32_t>((old_data[bit >> 6] >> (bit & 63)) & old_mask));
+	}
+}
+
+unsigned int PaletteStorage::bits_for(std::size_t palette_size)
+{
+	if (palette_size <= 1) return 0;
+	if (palette_size <= 2) return 1;
+	if (palette_size <= 4) return 2;
+	if (palette_size <= 16) return 4;
+	if (palette_size <= 256) return 8;
+	return 16;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Voxel id storage as a palette of distinct ids plus bit-packed palette indices.
+// The index width grows through 0/1/2/4/8 bits as ids are added (16 once a chunk holds
+// more than 256 distinct ids), so uniform chunks cost only their one palette entry.
+class PaletteStorage
+{
+public:
+	explicit PaletteStorage(std::size_t size, std::uint16_t fill_id = 0);
+
+	std::uint16_t get(std::size_t index) const;
+	void set(std::size_t index, std::uint16_t id);
+	void fill(std::uint16_t id);
+	// Replaces every entry with ids[0..size), packing at the final width in one pass.
+	void assign(const std::uint16_t* ids);
+
+	// Drops palette entries that are no longer referenced and narrows the index width.
+	void compact();
+
+	std::size_t size() const { return m_size; }
+	unsigned int get_bits_per_entry() const { return m_bits; }
+	const std::vector<std::uint16_t>& get_palette() const { return m_palette; }
+	std::size_t get_memory_usage() const;
+
+private:
+	std::uint32_t get_index(std::size_t index) const;
+	void set_index(std::size_t index, std::uint32_t palette_index);
+	std::uint32_t find_or_add(std::uint16_t id);
+	void repack(unsigned int bits);
+
+	static unsigned int bits_for(std::size_t palette_size);
+
+	std::size_t m_size;
+	unsigned int m_bits = 0;
+	std::vector<std::uint16_t> m_palette;
+	std::vector<std::uint64_t> m_data;
+};
@@ -0,0 +1,18 @@
+#include "TerrainGenerator.hpp"
+
+
+void SphereTerrainGenerator::generate(glm::ivec3, glm::ivec3 size, std::uint32_t, std::uint16_t* ids) const
+{
+	const int radius = size.x / 2;
+	const glm::ivec3 center = size / 2;
+
+	std::size_t i = 0;
+	for (int z = 0; z < size.z; z++) {
+		for (int y = 0; y < size.y; y++) {
+			for (int x = 0; x < size.x; x++, i++) {
+				const int dx = x - center.x, dy = y - center.y, dz = z - center.z;
+				ids[i] = (dx * dx + dy * dy + dz * dz < radius * radius) ? 1 : 0;
+			}
+		}
+	}
+}
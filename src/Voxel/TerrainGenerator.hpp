@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <glm/vec3.hpp>
+
+#include <Voxel/Chunk.hpp>
+
+// Produces the voxels of a chunk from its position and the world seed.
+// Output may depend on nothing else: chunks are generated in any order and on
+// several threads at once, and the same seed must always give the same world.
+class TerrainGenerator
+{
+public:
+	virtual ~TerrainGenerator() = default;
+
+	// Fills ids with the size.x * size.y * size.z voxels starting at world voxel origin,
+	// x fastest, then y, then z. Any chunk configuration can be generated this way.
+	virtual void generate(glm::ivec3 origin, glm::ivec3 size, std::uint32_t seed, std::uint16_t* ids) const = 0;
+
+	template <typename ChunkT = Chunk>
+	std::shared_ptr<ChunkT> create_chunk(glm::ivec3 chunk_pos, std::uint32_t seed) const
+	{
+		constexpr glm::ivec3 size{ int(ChunkT::CHUNK_X), int(ChunkT::CHUNK_Y), int(ChunkT::CHUNK_Z) };
+
+		thread_local std::uint16_t ids[ChunkT::CHUNK_VOLUME];
+		generate(chunk_pos * size, size, seed, ids);
+		return std::make_shared<ChunkT>(ids);
+	}
+};
+
+// One solid sphere per chunk, the original test scene.
+class SphereTerrainGenerator : public TerrainGenerator
+{
+public:
+	void generate(glm::ivec3 origin, glm::ivec3 size, std::uint32_t seed, std::uint16_t* ids) const override;
+};
@@ -1,100 +1,383 @@
 #include "World.hpp"
 
 #include <iostream>
+#include <chrono>
+#include <cmath>
+#include <limits>
 
-#include <glm/gtc/matrix_transform.hpp>
+#include <glm/geometric.hpp>
 
 #include <Resources/ResourceManager.hpp>
 
 #include <common/ImGuiWrapper.hpp>
 #include <common/Log.hpp>
+#include <common/ThreadPool.hpp>
 
 
 
-static inline std::size_t idx(std::size_t x, std::size_t y, std::size_t z, glm::ivec3 world_size) {
-	return (x + world_size.x * (y + world_size.y * z));
+World::World(std::string_view texture_atlas_name, std::shared_ptr<const TerrainGenerator> generator, std::uint32_t seed,
+			 VoxelMesher::EMode mesher_mode)
+	: m_generator(std::move(generator)),
+	  m_seed(seed),
+	  m_texture_atlas_name(texture_atlas_name),
+	  m_mesher_mode(mesher_mode)
+{
 }
 
+void World::add_chunk(glm::ivec3 pos, std::shared_ptr<Chunk> chunk)
+{
+	m_grid.add_chunk(pos, std::move(chunk));
 
+	// Meshed face neighbours emitted their border against air; they see this chunk now.
+	for (const glm::ivec3 offset : { glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0), glm::ivec3(0, 1, 0),
+									 glm::ivec3(0, -1, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1) }) {
+		const auto& neighbour = m_grid.get_neighbourhood(pos).get(offset.x, offset.y, offset.z);
+		if (neighbour && !neighbour->is_dirty() && m_mesh_tickets.contains(neighbour->m_pos)) {
+			neighbour->mark_dirty();
+			queue_remesh(neighbour);
+		}
+	}
+}
 
-World::World(std::size_t x_size, std::size_t y_size, std::size_t z_size, std::string_view texture_atlas_name)
-	: m_world_size(x_size, y_size, z_size),
-	  m_chunks(x_size * y_size * z_size),
-	  m_meshes(x_size* y_size* z_size),
-	  m_texture_atlas_name(texture_atlas_name)
+std::shared_ptr<Chunk> World::remove_chunk(glm::ivec3 pos)
 {
-	for (std::size_t y = 0; y < m_world_size.y; y++) {
-		for (std::size_t z = 0; z < m_world_size.z; z++) {
-			for (std::size_t x = 0; x < m_world_size.x; x++) {
-				auto index = idx(x, y, z, m_world_size);
-				m_chunks[index] = std::make_shared<Chunk>();
-				m_chunks[index]->m_pos = { x,y,z };
-			}
+	auto chunk = m_grid.get_chunk(pos);
+	if (!chunk) return nullptr;
+
+	m_grid.remove_chunk(pos);
+	m_renderer.remove(pos);
+	m_mesh_tickets.erase(pos); // drops any build still on its way
+	chunk->clear_dirty(); // remesh_dirty_chunks skips chunks that are no longer in the grid
+	return chunk;
+}
+
+void World::mesh_chunks(const std::vector<glm::ivec3>& positions)
+{
+	m_build_stats.thread_count = ThreadPool::get().get_thread_count();
+
+	for (const auto& pos : positions) {
+		const auto& neighbourhood = m_grid.get_neighbourhood(pos);
+		if (!neighbourhood.center()) continue;
+
+		// The build sees the voxels as they are now; later edits queue another one.
+		neighbourhood.center()->clear_dirty();
+
+		const auto* tickets = m_mesh_tickets.find(pos);
+		if (!tickets) {
+			queue_build(neighbourhood, pos, select_lod(pos));
+			continue;
 		}
+
+		const auto kept = *tickets; // queue_build may grow the map
+		for (int lod = 0; lod < CHUNK_LOD_COUNT; lod++)
+			if (kept[lod] != 0) queue_build(neighbourhood, pos, lod);
 	}
+	m_build_stats.builds_in_flight = m_builds_in_flight;
+}
+
+void World::queue_build(const ChunkNeighbourhood& neighbourhood, glm::ivec3 pos, int lod)
+{
+	const std::uint64_t ticket = m_next_ticket++;
+	m_mesh_tickets[pos][lod] = ticket;
+	m_builds_in_flight++;
+	m_mesh_results->building++;
+
+	ThreadPool::get().submit([results = m_mesh_results, neighbourhood, pos, lod, ticket, mode = m_mesher_mode] {
+		const auto start = std::chrono::steady_clock::now();
+		ChunkMeshData data = VoxelMesher::build_mesh_data(neighbourhood, mode, lod);
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		results->building--;
+
+		std::lock_guard lock(results->mutex);
+		results->ready.push_back({ pos, lod, ticket, std::move(data), seconds });
+	});
+}
+
+std::size_t World::update_lods(glm::vec3 camera_position, std::size_t budget)
+{
+	m_camera_position = camera_position;
+
+	std::vector<std::pair<glm::ivec3, int>> builds;
+	std::vector<std::pair<glm::ivec3, int>> drops;
+	m_mesh_tickets.for_each([&](glm::ivec3 pos, const std::array<std::uint64_t, CHUNK_LOD_COUNT>& tickets) {
+		const int lod = select_lod(pos);
+		if (tickets[lod] == 0) {
+			if (builds.size() < budget) builds.emplace_back(pos, lod);
+			return;
+		}
+		if (!m_renderer.contains(pos, lod)) return; // keep drawing the others meanwhile
+
+		// The levels next to the selected one stay, so crossing a boundary back and forth is free.
+		for (int other = 0; other < CHUNK_LOD_COUNT; other++)
+			if (tickets[other] != 0 && std::abs(other - lod) > 1)
+				drops.emplace_back(pos, other);
+	});
+
+	for (const auto& [pos, lod] : drops) {
+		m_renderer.remove(pos, lod);
+		(*m_mesh_tickets.find(pos))[lod] = 0; // drops any build still on its way
+	}
+
+	for (const auto& [pos, lod] : builds) {
+		const auto& neighbourhood = m_grid.get_neighbourhood(pos);
+		if (neighbourhood.center()) queue_build(neighbourhood, pos, lod);
+	}
+	m_build_stats.builds_in_flight = m_builds_in_flight;
+	return builds.size();
+}
+
+int World::select_lod(glm::ivec3 pos) const
+{
+	if (m_lod_distance <= 0.f) return 0;
+
+	const glm::vec3 chunk_size = { Chunk::CHUNK_X, Chunk::CHUNK_Y, Chunk::CHUNK_Z };
+	const glm::vec3 center = glm::vec3(pos) * chunk_size + (chunk_size - 1.f) * 0.5f;
+	const float distance = glm::length(center - m_camera_position) / chunk_size.x;
+
+	int lod = 0;
+	for (float limit = m_lod_distance; lod + 1 < CHUNK_LOD_COUNT && distance >= limit; limit *= 2.f)
+		lod++;
+	return lod;
+}
+
+int World::resident_lod(std::uint32_t lods, int lod)
+{
+	for (int step = 0; step < CHUNK_LOD_COUNT; step++) {
+		if (lod - step >= 0 && (lods >> (lod - step)) & 1) return lod - step;
+		if (lod + step < CHUNK_LOD_COUNT && (lods >> (lod + step)) & 1) return lod + step;
+	}
+	return lod;
+}
+
+std::size_t World::upload_meshes(std::size_t budget_bytes)
+{
+	{
+		std::lock_guard lock(m_mesh_results->mutex);
+		for (auto& result : m_mesh_results->ready)
+			m_upload_queue.push_back(std::move(result));
+		m_mesh_results->ready.clear();
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	BuildStats stats;
+	stats.thread_count = m_build_stats.thread_count;
+
+	while (!m_upload_queue.empty()) {
+		MeshResult& result = m_upload_queue.front();
+
+		const auto* tickets = m_mesh_tickets.find(result.pos);
+		if (tickets && (*tickets)[result.lod] == result.ticket) {
+			const std::size_t bytes = result.data.vertices.size() * sizeof(ChunkVertex);
+			if (stats.uploaded > 0 && stats.uploaded_bytes + bytes > budget_bytes) break;
+
+			// Replaces the previous mesh between two draws, so the chunk is never missing.
+			m_renderer.upload(result.pos, result.lod, result.data);
+			stats.uploaded++;
+			stats.uploaded_bytes += bytes;
+			stats.mesh_seconds += result.seconds;
+		}
+
+		m_upload_queue.pop_front();
+		m_builds_in_flight--;
+	}
+	m_renderer.defragment();
+
+	stats.upload_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	stats.builds_in_flight = m_builds_in_flight;
+	m_build_stats = stats;
+	return stats.uploaded;
+}
 
-	for (std::size_t i = 0; i < m_chunks.size(); ++i) {
-		auto chunk = m_chunks[i];
+void World::draw(const std::shared_ptr<ShaderProgram> shader, const Camera& camera)
+{
+	const glm::mat4 projview = camera.get_projection_matrix() * camera.get_view_matrix();
+	const Frustum frustum(projview);
+	const glm::ivec3 chunk_size = { Chunk::CHUNK_X, Chunk::CHUNK_Y, Chunk::CHUNK_Z };
+	const auto texture = ResourceManager::get_texture(m_texture_atlas_name);
 
-		std::vector<std::shared_ptr<Chunk>> closes(27, nullptr);
+	m_draw_stats = {};
+	m_visible_chunks.clear();
+	m_render_queue.clear();
 
-		for (std::size_t j = 0; j < m_chunks.size(); ++j) {
-			auto other = m_chunks[j];
+	m_renderer.for_each_mesh([&](glm::ivec3 pos, std::uint32_t lods) {
+		const int lod = resident_lod(lods, select_lod(pos));
+		const std::uint32_t vertex_count = m_renderer.get_vertex_count(pos, lod);
+		if (vertex_count == 0) {
+			m_draw_stats.chunks_empty++;
+			return;
+		}
 
-			int ox = other->m_pos.x - chunk->m_pos.x;
-			int oy = other->m_pos.y - chunk->m_pos.y;
-			int oz = other->m_pos.z - chunk->m_pos.z;
+		const glm::vec3 chunkPos(pos * chunk_size);
 
-			if (std::abs(ox) > 1 || std::abs(oy) > 1 || std::abs(oz) > 1)
-				continue;
+		// Voxel centres sit on integer coordinates, so the chunk spans -0.5..CHUNK-0.5.
+		if (!frustum.intersects_aabb(chunkPos - 0.5f, chunkPos + glm::vec3(chunk_size) - 0.5f)) {
+			m_draw_stats.chunks_culled++;
+			return;
+		}
+
+		const float depth = glm::length(chunkPos + (glm::vec3(chunk_size) - 1.f) * 0.5f - camera.get_position());
+		m_render_queue.push(RenderQueue::EPass::Opaque, *shader, *texture, m_renderer.get_page(pos, lod), depth,
+							static_cast<std::uint32_t>(m_visible_chunks.size()));
+		m_visible_chunks.push_back({ pos, lod });
+		m_draw_stats.chunks_per_lod[lod]++;
+		m_draw_stats.vertices_drawn += vertex_count;
+	});
+	m_draw_stats.chunks_drawn = m_visible_chunks.size();
+
+	m_render_queue.sort();
+	// projview comes from the FrameUniforms block, bound once for the frame.
+	m_draw_stats.batches = m_render_queue.submit([&](const RenderQueue::Batch& batch) {
+		m_batch_chunks.clear();
+		for (const auto& item : batch.items)
+			m_batch_chunks.push_back(m_visible_chunks[item.payload]);
+		m_draw_stats.draw_calls += m_renderer.draw(m_batch_chunks, chunk_size, camera, ImGuiWrapper::draw_line ? GL_LINES : GL_TRIANGLES);
+	});
+	m_draw_stats.vertices_skipped = m_renderer.get_vertices_skipped();
+	m_draw_stats.vertices_drawn -= m_draw_stats.vertices_skipped;
+	m_renderer.end_frame();
+}
+
+
+
+static inline int floor_div(int v, int size) { return (v < 0) ? ((v + 1) / size - 1) : (v / size); }
+
+static inline glm::ivec3 chunk_of(glm::ivec3 pos)
+{
+	return { floor_div(pos.x, Chunk::CHUNK_X), floor_div(pos.y, Chunk::CHUNK_Y), floor_div(pos.z, Chunk::CHUNK_Z) };
+}
 
-			ox++; oy++; oz++; // 0..2
-			closes[(oy * 3 + oz) * 3 + ox] = other;
+std::uint16_t World::get_voxel(glm::ivec3 pos) const
+{
+	const glm::ivec3 chunk_pos = chunk_of(pos);
+	const auto chunk = m_grid.get_chunk(chunk_pos);
+	if (!chunk) return 0;
+
+	const glm::ivec3 local = pos - chunk_pos * glm::ivec3(Chunk::CHUNK_X, Chunk::CHUNK_Y, Chunk::CHUNK_Z);
+	return chunk->get_id(local.x, local.y, local.z);
+}
+
+bool World::is_solid(glm::ivec3 pos) const
+{
+	const glm::ivec3 chunk_pos = chunk_of(pos);
+	const auto chunk = m_grid.get_chunk(chunk_pos);
+	if (!chunk) return false;
+
+	const glm::ivec3 local = pos - chunk_pos * glm::ivec3(Chunk::CHUNK_X, Chunk::CHUNK_Y, Chunk::CHUNK_Z);
+	return chunk->is_solid(local.x, local.y, local.z);
+}
+
+bool World::set_voxel(glm::ivec3 pos, std::uint16_t id)
+{
+	const glm::ivec3 chunk_pos = chunk_of(pos);
+	auto chunk = m_grid.get_chunk(chunk_pos);
+	if (!chunk) return false;
+
+	const glm::ivec3 size = { Chunk::CHUNK_X, Chunk::CHUNK_Y, Chunk::CHUNK_Z };
+	const glm::ivec3 local = pos - chunk_pos * size;
+	if (chunk->get_id(local.x, local.y, local.z) == id) return true;
+
+	// Background builds may be reading the chunk: edit a copy and link it in instead.
+	// The builds finish on the old voxels and are superseded by the remesh queued below.
+	if (m_mesh_results->building.load() != 0) {
+		chunk = std::make_shared<Chunk>(*chunk);
+		m_grid.add_chunk(chunk_pos, chunk);
+		if (chunk->is_dirty()) queue_remesh(chunk); // the queued original is skipped now
+	}
+
+	// The id differs (checked above), so the voxel changes; a dirty chunk is already queued.
+	const bool was_dirty = chunk->is_dirty();
+	chunk->set_id(local.x, local.y, local.z, id);
+	if (!was_dirty) queue_remesh(chunk);
+
+	// A voxel on a border is also the neighbour chunk's culling border.
+	for (int axis = 0; axis < 3; axis++) {
+		glm::ivec3 offset{ 0, 0, 0 };
+		if (local[axis] == 0) offset[axis] = -1;
+		else if (local[axis] == size[axis] - 1) offset[axis] = 1;
+		else continue;
+
+		const auto& neighbour = m_grid.get_neighbourhood(chunk_pos).get(offset.x, offset.y, offset.z);
+		if (neighbour && !neighbour->is_dirty()) {
+			neighbour->mark_dirty();
+			queue_remesh(neighbour);
+		}
+	}
+	return true;
+}
+
+std::optional<glm::ivec3> World::raycast(glm::vec3 origin, glm::vec3 direction, float max_distance) const
+{
+	// Voxel centres are on integer coordinates, shift so that cells span [n, n + 1).
+	const glm::vec3 start = origin + 0.5f;
+	glm::ivec3 cell = { std::floor(start.x), std::floor(start.y), std::floor(start.z) };
+
+	glm::ivec3 step;
+	glm::vec3 t_max, t_delta;
+	for (int a = 0; a < 3; a++) {
+		step[a] = (direction[a] > 0.f) ? 1 : (direction[a] < 0.f ? -1 : 0);
+		if (step[a] == 0) {
+			t_max[a] = t_delta[a] = std::numeric_limits<float>::infinity();
+			continue;
 		}
+		const float boundary = (step[a] > 0) ? cell[a] + 1.f : static_cast<float>(cell[a]);
+		t_max[a] = (boundary - start[a]) / direction[a];
+		t_delta[a] = std::abs(1.f / direction[a]);
+	}
+
+	// The chunk is looked up again only when the ray crosses into another one.
+	const glm::ivec3 chunk_size = { Chunk::CHUNK_X, Chunk::CHUNK_Y, Chunk::CHUNK_Z };
+	glm::ivec3 chunk_pos = chunk_of(cell);
+	std::shared_ptr<Chunk> chunk = m_grid.get_chunk(chunk_pos);
 
-		m_meshes[i] = VoxelMesher::build_mesh(chunk, closes);
-
-	} 
-}
-
-void World::draw(const std::shared_ptr<ShaderProgram> shader, const Camera& camera) const
-{
-	for (std::size_t y = 0; y < m_world_size.y; y++) {
-		for (std::size_t z = 0; z < m_world_size.z; z++) {
-			for (std::size_t x = 0; x < m_world_size.x; x++) {
-				auto index = idx(x, y, z, m_world_size);
-				
-				glm::vec3 chunkPos = {
-					x * Chunk::CHUNK_X,
-					y * Chunk::CHUNK_Y,
-					z * Chunk::CHUNK_Z
-				};
-				 
-				
-				glm::mat4 model_matrix = glm::translate(glm::mat4(1.f), chunkPos);
-				
-				shader->bind();
-				shader->set_matrix4("model", model_matrix);
-				shader->set_matrix4("projview", camera.get_projection_matrix() * camera.get_view_matrix());
-				ResourceManager::get_texture(m_texture_atlas_name)->bind();
-
-
-
-				if (ImGuiWrapper::draw_line) {
-					m_meshes[index]->draw(GL_LINES);
-				}
-				else {
-					m_meshes[index]->draw(GL_TRIANGLES);
-				}
-			}
+	for (float t = 0.f; t <= max_distance;) {
+		if (chunk_of(cell) != chunk_pos) {
+			chunk_pos = chunk_of(cell);
+			chunk = m_grid.get_chunk(chunk_pos);
 		}
+		const glm::ivec3 local = cell - chunk_pos * chunk_size;
+		if (chunk && chunk->is_solid(local.x, local.y, local.z)) return cell;
+
+		const int a = (t_max.x < t_max.y) ? (t_max.x < t_max.z ? 0 : 2) : (t_max.y < t_max.z ? 1 : 2);
+		cell[a] += step[a];
+		t = t_max[a];
+		t_max[a] += t_delta[a];
 	}
+	return std::nullopt;
 }
 
+void World::queue_remesh(const std::shared_ptr<Chunk>& chunk)
+{
+	m_dirty_chunks.push_back(chunk);
+}
+
+std::size_t World::remesh_dirty_chunks()
+{
+	if (m_dirty_chunks.empty()) return 0;
+
+	std::vector<glm::ivec3> positions;
+	positions.reserve(m_dirty_chunks.size());
+	for (const auto& chunk : m_dirty_chunks)
+		if (m_grid.get_chunk(chunk->m_pos) == chunk)
+			positions.push_back(chunk->m_pos);
+	m_dirty_chunks.clear();
+
+	mesh_chunks(positions);
+	return positions.size();
+}
+
+std::shared_ptr<Chunk> World::get_chunk(glm::ivec3 pos) const
+{
+	return m_grid.get_chunk(pos);
+}
 
+std::size_t World::get_vertex_count() const
+{
+	return m_renderer.get_vertex_count();
+}
 
-std::shared_ptr<Chunk> World::get_chunk(std::size_t x, std::size_t y, std::size_t z) const
+std::size_t World::get_chunk_memory_usage() const
 {
-	if (x < 0 || y < 0 || z < 0 || x >= m_world_size.x || y >= m_world_size.y|| z >= m_world_size.z) return nullptr;
-	return m_chunks[idx(x, y, z, m_world_size)];
+	std::size_t bytes = 0;
+	m_grid.for_each_chunk([&](const std::shared_ptr<Chunk>& chunk) { bytes += chunk->get_memory_usage(); });
+	return bytes;
 }
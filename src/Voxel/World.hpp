@@ -1,16 +1,25 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <deque>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 
 #include <Voxel/Chunk.hpp>
+#include <Voxel/ChunkGrid.hpp>
+#include <Voxel/ChunkMap.hpp>
+#include <Voxel/TerrainGenerator.hpp>
 #include <Voxel/Voxel.hpp>
 
-#include <Object/Mesh.hpp>
-
 #include <Render/VoxelMesher.hpp>
+#include <Render/ChunkRenderer.hpp>
 #include <Render/Camera.hpp>
+#include <Render/Frustum.hpp>
+#include <Render/RenderQueue.hpp>
 
 
 #include <OpenGL/ShaderProgram.hpp>
@@ -21,15 +30,136 @@
 class World
 {
 public:
-	World(std::size_t x_size, std::size_t y_size, std::size_t z_size, std::string_view texture_atlas_name);
+	// Mesh pipeline counters of the last upload_meshes call.
+	struct BuildStats
+	{
+		double mesh_seconds = 0.0;        // CPU meshing of the uploaded meshes, summed over workers
+		double upload_seconds = 0.0;      // GL buffer creation on the context thread
+		std::size_t uploaded = 0;         // meshes made resident
+		std::size_t uploaded_bytes = 0;
+		std::size_t builds_in_flight = 0; // queued, building or waiting for upload
+		std::size_t thread_count = 0;
+	};
+
+	// Chunk counts of the last draw call.
+	struct DrawStats
+	{
+		std::size_t chunks_drawn = 0;
+		std::size_t chunks_culled = 0; // outside the view frustum
+		std::size_t chunks_empty = 0;  // no geometry, skipped before culling
+		std::size_t batches = 0;       // runs of the render queue sharing GL state
+		std::size_t draw_calls = 0;
+		std::array<std::size_t, CHUNK_LOD_COUNT> chunks_per_lod{}; // drawn chunks by level of detail
+		std::size_t vertices_drawn = 0;
+		std::size_t vertices_skipped = 0; // face directions of drawn chunks facing away from the camera
+	};
+
+	// Starts empty, chunks are added and removed by the caller (see ChunkStreamer).
+	World(std::string_view texture_atlas_name, std::shared_ptr<const TerrainGenerator> generator, std::uint32_t seed,
+		  VoxelMesher::EMode mesher_mode = VoxelMesher::EMode::Naive);
+
+	// Runs the terrain generator for pos; safe to call from several threads.
+	std::shared_ptr<Chunk> generate_chunk(glm::ivec3 pos) const { return m_generator->create_chunk(pos, m_seed); }
+	std::uint32_t get_seed() const { return m_seed; }
+
+	// Links the chunk into the grid; it is drawn once meshed.
+	void add_chunk(glm::ivec3 pos, std::shared_ptr<Chunk> chunk);
+	// Unlinks the chunk and frees its mesh. The returned chunk keeps its voxels.
+	std::shared_ptr<Chunk> remove_chunk(glm::ivec3 pos);
+	// Queues background builds of the chunks' meshes, of every level a chunk has or
+	// waits for, else of the level its distance selects. A chunk keeps drawing its
+	// current mesh until upload_meshes makes the new one resident.
+	void mesh_chunks(const std::vector<glm::ivec3>& positions);
+	// Uploads finished builds, oldest first, until budget_bytes of vertex data went to the
+	// GPU this call (at least one mesh, so large meshes still get through). Builds that a
+	// newer one superseded are dropped. Also compacts a fragmented page of the mesh arena
+	// if there is one. Returns the number of meshes uploaded.
+	std::size_t upload_meshes(std::size_t budget_bytes);
+	bool has_mesh(glm::ivec3 pos, int lod = 0) const { return m_renderer.contains(pos, lod); }
+
+	// Chunks closer than distance (in chunks) are drawn at full resolution, each doubling
+	// of it selects the next coarser level. 0 draws everything at full resolution.
+	void set_lod_distance(float distance) { m_lod_distance = distance; }
+	float get_lod_distance() const { return m_lod_distance; }
+	// Queues builds, at most budget, of the levels the camera moved into, and frees the
+	// levels more than one step from the selected one once that is resident. Call before
+	// the streamer's update so new chunks are meshed at the right level.
+	std::size_t update_lods(glm::vec3 camera_position, std::size_t budget);
+
+	// Queues the visible chunks front to back, then draws each run sharing shader, texture
+	// and arena page with one indirect multi-draw. Chunks whose selected level is not
+	// resident yet draw the nearest level that is. Face directions that face away from
+	// the camera over a whole chunk are left out. The camera matrices come from
+	// FrameUniforms, which must be updated for this frame. Ends the frame for the
+	// renderer's stream buffer, so call it once per frame after uploading.
+	void draw(const std::shared_ptr<ShaderProgram> shader, const Camera& camera);
 
-	void draw(const std::shared_ptr<ShaderProgram> shader, const Camera& camera) const;
+	std::shared_ptr<Chunk> get_chunk(glm::ivec3 pos) const;
+	const ChunkGrid& get_grid() const { return m_grid; }
 
-	std::shared_ptr<Chunk> get_chunk(std::size_t x, std::size_t y, std::size_t z) const;
+	// Voxels in world coordinates; unloaded chunks read as air and ignore writes.
+	std::uint16_t get_voxel(glm::ivec3 pos) const;
+	bool set_voxel(glm::ivec3 pos, std::uint16_t id);
+	// Reads the chunk's occupancy mask, cheaper than get_voxel when the id is not needed.
+	bool is_solid(glm::ivec3 pos) const;
+
+	// First solid voxel along the ray, if any within max_distance.
+	std::optional<glm::ivec3> raycast(glm::vec3 origin, glm::vec3 direction, float max_distance) const;
+
+	// Queues mesh builds for chunks edited since the last call. Each chunk is meshed
+	// once however many of its voxels changed. Returns the number of builds queued.
+	std::size_t remesh_dirty_chunks();
+
+	std::size_t get_vertex_count() const;
+	std::size_t get_chunk_memory_usage() const;
+	const BuildStats& get_build_stats() const { return m_build_stats; }
+	const DrawStats& get_draw_stats() const { return m_draw_stats; }
+	MeshArena::Stats get_mesh_arena_stats() const { return m_renderer.get_arena_stats(); }
+	const StreamBuffer::Stats& get_stream_stats() const { return m_renderer.get_stream_stats(); }
 
 private:
-	std::vector<std::shared_ptr<Chunk>> m_chunks;
-	std::vector<std::shared_ptr<Mesh>> m_meshes;
+	struct MeshResult
+	{
+		glm::ivec3 pos;
+		int lod;
+		std::uint64_t ticket;
+		ChunkMeshData data;
+		double seconds;
+	};
+
+	// Handed to the pool's workers, so it outlives the world if builds are still running.
+	struct MeshResults
+	{
+		std::mutex mutex;
+		std::vector<MeshResult> ready;
+		std::atomic<std::size_t> building{ 0 }; // jobs that may still read chunk voxels
+	};
+
+	void queue_remesh(const std::shared_ptr<Chunk>& chunk);
+	void queue_build(const ChunkNeighbourhood& neighbourhood, glm::ivec3 pos, int lod);
+	int select_lod(glm::ivec3 pos) const;
+	// The level to draw: lod if resident, else the nearest resident one, finer first.
+	static int resident_lod(std::uint32_t lods, int lod);
+
+	ChunkGrid m_grid;
+	ChunkRenderer m_renderer;
+	// Latest build requested per chunk and level, 0 for levels not kept; present once a
+	// chunk was ever sent for meshing.
+	ChunkMap<std::array<std::uint64_t, CHUNK_LOD_COUNT>> m_mesh_tickets;
+	std::uint64_t m_next_ticket = 1;
+	std::shared_ptr<MeshResults> m_mesh_results = std::make_shared<MeshResults>();
+	std::deque<MeshResult> m_upload_queue;
+	std::size_t m_builds_in_flight = 0;
+	std::vector<std::shared_ptr<Chunk>> m_dirty_chunks;
+	std::shared_ptr<const TerrainGenerator> m_generator;
+	std::uint32_t m_seed;
 	std::string m_texture_atlas_name;
-	glm::ivec3 m_world_size;
+	VoxelMesher::EMode m_mesher_mode;
+	float m_lod_distance = 0.f;
+	glm::vec3 m_camera_position{ 0.f };
+	BuildStats m_build_stats;
+	DrawStats m_draw_stats;
+	RenderQueue m_render_queue;
+	std::vector<ChunkRenderer::DrawItem> m_visible_chunks; // draw scratch
+	std::vector<ChunkRenderer::DrawItem> m_batch_chunks;
 };
\ No newline at end of file
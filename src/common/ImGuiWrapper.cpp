@@ -55,7 +55,26 @@ void ImGuiWrapper::update_imgui()
 
     ImGui::Separator();
     ImGui::Text("World settings");
-    ImGui::SliderInt3("World size", &world_size.x, 1, 10);
+    ImGui::SliderInt("View distance", &view_distance, 2, 64);
+    ImGui::SliderFloat("LOD distance (0 - off)", &lod_distance, 0.f, 16.f, "%.1f chunks");
+    ImGui::SliderInt("Chunk cache", &chunk_cache_size, 0, 4096);
+    ImGui::SliderInt("Upload budget (KiB/frame)", &mesh_upload_budget, 64, 16384);
+    ImGui::Combo("Mesher", &mesher_mode, "Naive\0Greedy\0");
+    ImGui::Combo("Terrain", &terrain_generator, "Spheres\0Noise\0");
+    ImGui::InputInt("Seed", &world_seed);
+    ImGui::Text("Vertices: %zu (%.1f KiB)", world_vertex_count, world_vertex_memory / 1024.0);
+    ImGui::Text("Chunk memory: %.1f KiB", world_chunk_memory / 1024.0);
+    ImGui::Text("Chunks drawn: %zu, culled: %zu, empty: %zu", chunks_drawn, chunks_culled, chunks_empty);
+    ImGui::Text("Chunks per LOD: %zu / %zu / %zu / %zu", chunks_per_lod[0], chunks_per_lod[1], chunks_per_lod[2], chunks_per_lod[3]);
+    ImGui::Text("Vertices drawn: %zu, facing away: %zu", vertices_drawn, vertices_skipped);
+    ImGui::Text("Batches: %zu, draw calls: %zu, GL binds: %zu (%zu skipped)", draw_batches, draw_calls, gl_binds, gl_skipped);
+    ImGui::Text("Chunks loaded: %zu, cached: %zu, pending: %zu", chunks_loaded, chunks_cached, chunks_pending);
+    ImGui::Text("Meshes in flight: %zu, uploaded: %zu", meshes_in_flight, meshes_uploaded);
+    ImGui::Text("Generate: %.2f ms, mesh: %.2f ms (%zu threads), upload: %.2f ms", generate_ms, mesh_ms, mesh_threads, upload_ms);
+    ImGui::Text("Mesh arena: %zu pages, %.1f / %.1f MiB, fragmentation %.0f%%", mesh_arena_pages,
+                mesh_arena_used / (1024.0 * 1024.0), mesh_arena_capacity / (1024.0 * 1024.0), mesh_arena_fragmentation * 100.f);
+    ImGui::Text("Stream buffer: %.1f KiB (%.1f KiB missed), GPU waits: %zu", stream_buffer_used / 1024.0,
+                stream_buffer_missed / 1024.0, stream_buffer_waits);
 	ImGui::End();
 
     ImGui::Render();
@@ -21,7 +21,42 @@ namespace ImGuiWrapper
 
 	inline float camera_fov = 120.f;
 
-	inline glm::ivec3 world_size { 1,1,3 };
+	inline int view_distance = 6; // chunks
+	inline float lod_distance = 4.f; // chunks drawn at full resolution, see World::set_lod_distance
+	inline int chunk_cache_size = 512;
+	inline int mesh_upload_budget = 2048; // KiB of vertex data uploaded per frame
+	inline int mesher_mode = 0; // VoxelMesher::EMode
+	inline int terrain_generator = 1; // 0 - sphere per chunk, 1 - noise terrain
+	inline int world_seed = 1337;
+	inline std::size_t world_vertex_count = 0;
+	inline std::size_t world_vertex_memory = 0;
+	inline std::size_t world_chunk_memory = 0;
+	inline std::size_t chunks_drawn = 0;
+	inline std::size_t chunks_culled = 0;
+	inline std::size_t chunks_empty = 0;
+	inline std::size_t chunks_per_lod[4] = {};
+	inline std::size_t vertices_drawn = 0;
+	inline std::size_t vertices_skipped = 0; // by chunk level face direction culling
+	inline std::size_t draw_batches = 0;
+	inline std::size_t draw_calls = 0;
+	inline std::size_t gl_binds = 0;   // last frame, program/VAO/texture binds that reached GL
+	inline std::size_t gl_skipped = 0; // and the ones the state cache dropped
+	inline std::size_t chunks_loaded = 0;
+	inline std::size_t chunks_cached = 0;
+	inline std::size_t chunks_pending = 0;
+	inline std::size_t meshes_in_flight = 0;
+	inline std::size_t meshes_uploaded = 0; // last frame
+	inline double generate_ms = 0.0; // last frame, chunk generation
+	inline double mesh_ms = 0.0;     // CPU meshing of the uploaded meshes, summed over workers
+	inline double upload_ms = 0.0;
+	inline std::size_t mesh_threads = 0;
+	inline std::size_t mesh_arena_pages = 0;
+	inline std::size_t mesh_arena_used = 0;     // bytes
+	inline std::size_t mesh_arena_capacity = 0; // bytes
+	inline float mesh_arena_fragmentation = 0.f;
+	inline std::size_t stream_buffer_used = 0;   // bytes, last frame
+	inline std::size_t stream_buffer_missed = 0; // bytes that took the glBufferSubData path
+	inline std::size_t stream_buffer_waits = 0;
 
 	inline std::string camera_pos_string;
 	inline float camera_speed = 20.f;
@@ -0,0 +1,125 @@
+#include "Noise.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include <common/NoiseKernels.hpp>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define NOISE_X86 1
+#endif
+
+
+using ScalarKernels = NoiseKernels::Kernels<NoiseKernels::ScalarLanes>;
+
+
+static Noise::EBackend detect_backend()
+{
+#if defined(NOISE_X86) && defined(_MSC_VER)
+	int regs[4];
+	__cpuid(regs, 1);
+	const bool sse41 = (regs[2] >> 19) & 1;
+	const bool os_avx = ((regs[2] >> 27) & 1) && ((regs[2] >> 28) & 1) && (_xgetbv(0) & 6) == 6;
+	__cpuidex(regs, 7, 0);
+	const bool avx2 = os_avx && ((regs[1] >> 5) & 1);
+#elif defined(NOISE_X86)
+	__builtin_cpu_init();
+	const bool sse41 = __builtin_cpu_supports("sse4.1");
+	const bool avx2 = __builtin_cpu_supports("avx2");
+#else
+	const bool sse41 = false, avx2 = false;
+#endif
+
+	if (avx2) return Noise::EBackend::AVX2;
+	if (sse41) return Noise::EBackend::SSE41;
+	return Noise::EBackend::Scalar;
+}
+
+static std::atomic<Noise::EBackend>& current_backend()
+{
+	static std::atomic<Noise::EBackend> backend{ Noise::get_supported_backend() };
+	return backend;
+}
+
+
+float Noise::perlin2(float x, float y, std::uint32_t seed)
+{
+	return ScalarKernels::perlin(x, y, seed);
+}
+
+float Noise::perlin3(float x, float y, float z, std::uint32_t seed)
+{
+	return ScalarKernels::perlin(x, y, z, seed);
+}
+
+float Noise::fbm2(float x, float y, std::uint32_t seed, int octaves, float lacunarity, float gain)
+{
+	return ScalarKernels::fbm(x, y, seed, octaves, lacunarity, gain);
+}
+
+float Noise::fbm3(float x, float y, float z, std::uint32_t seed, int octaves, float lacunarity, float gain)
+{
+	return ScalarKernels::fbm(x, y, z, seed, octaves, lacunarity, gain);
+}
+
+void Noise::fbm2_grid(std::int32_t x0, std::int32_t y0, int width, int height, float frequency,
+					  std::uint32_t seed, int octaves, float* out, float lacunarity, float gain)
+{
+	switch (get_backend()) {
+#ifdef NOISE_X86
+	case EBackend::AVX2:
+		NoiseKernels::fbm2_grid_avx2(x0, y0, width, height, frequency, seed, octaves, lacunarity, gain, out);
+		break;
+	case EBackend::SSE41:
+		NoiseKernels::fbm2_grid_sse41(x0, y0, width, height, frequency, seed, octaves, lacunarity, gain, out);
+		break;
+#endif
+	default:
+		ScalarKernels::fbm2_grid(x0, y0, width, height, frequency, seed, octaves, lacunarity, gain, out);
+		break;
+	}
+}
+
+void Noise::fbm3_grid(std::int32_t x0, std::int32_t y0, std::int32_t z0, int width, int height, int depth,
+					  float frequency, std::uint32_t seed, int octaves, float* out, float lacunarity, float gain)
+{
+	switch (get_backend()) {
+#ifdef NOISE_X86
+	case EBackend::AVX2:
+		NoiseKernels::fbm3_grid_avx2(x0, y0, z0, width, height, depth, frequency, seed, octaves, lacunarity, gain, out);
+		break;
+	case EBackend::SSE41:
+		NoiseKernels::fbm3_grid_sse41(x0, y0, z0, width, height, depth, frequency, seed, octaves, lacunarity, gain, out);
+		break;
+#endif
+	default:
+		ScalarKernels::fbm3_grid(x0, y0, z0, width, height, depth, frequency, seed, octaves, lacunarity, gain, out);
+		break;
+	}
+}
+
+std::uint32_t Noise::hash(std::int32_t x, std::int32_t y, std::int32_t z, std::uint32_t seed)
+{
+	return ScalarKernels::hash(static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y), static_cast<std::uint32_t>(z), seed);
+}
+
+Noise::EBackend Noise::get_backend()
+{
+	return current_backend().load(std::memory_order_relaxed);
+}
+
+void Noise::set_backend(EBackend backend)
+{
+	current_backend().store(std::min(backend, get_supported_backend()), std::memory_order_relaxed);
+}
+
+Noise::EBackend Noise::get_supported_backend()
+{
+	static const EBackend supported = detect_backend();
+	return supported;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+// Seeded gradient noise. Lattice gradients come from hashing the cell with the seed,
+// so there are no permutation tables to build and any seed is free to use.
+// Results are deterministic across threads, call order and SIMD backends.
+class Noise
+{
+public:
+	enum class EBackend
+	{
+		Scalar,
+		SSE41,
+		AVX2
+	};
+
+	Noise() = delete;
+
+	// Roughly -1..1.
+	static float perlin2(float x, float y, std::uint32_t seed);
+	static float perlin3(float x, float y, float z, std::uint32_t seed);
+
+	// Sum of octaves, each at lacunarity times the frequency and gain times the
+	// amplitude of the previous one, normalised back to roughly -1..1.
+	static float fbm2(float x, float y, std::uint32_t seed, int octaves, float lacunarity = 2.f, float gain = 0.5f);
+	static float fbm3(float x, float y, float z, std::uint32_t seed, int octaves, float lacunarity = 2.f, float gain = 0.5f);
+
+	// fbm over a block of integer lattice points, sampled at (x0 + x) * frequency and so on,
+	// x fastest. Bit-identical to calling fbm2 / fbm3 per point, but vectorised.
+	static void fbm2_grid(std::int32_t x0, std::int32_t y0, int width, int height, float frequency,
+						  std::uint32_t seed, int octaves, float* out, float lacunarity = 2.f, float gain = 0.5f);
+	static void fbm3_grid(std::int32_t x0, std::int32_t y0, std::int32_t z0, int width, int height, int depth,
+						  float frequency, std::uint32_t seed, int octaves, float* out, float lacunarity = 2.f, float gain = 0.5f);
+
+	static std::uint32_t hash(std::int32_t x, std::int32_t y, std::int32_t z, std::uint32_t seed);
+
+	// Widest backend the CPU supports, picked on first use. set_backend is clamped to it.
+	static EBackend get_backend();
+	static void set_backend(EBackend backend);
+	static EBackend get_supported_backend();
+};
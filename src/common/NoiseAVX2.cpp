@@ -0,0 +1,65 @@
+#include <common/NoiseKernels.hpp>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <immintrin.h>
+
+namespace
+{
+	struct AVX2Lanes
+	{
+		using F = __m256;
+		using I = __m256i;
+		using M = __m256;
+		static constexpr int LANES = 8;
+
+		static F set(float v) { return _mm256_set1_ps(v); }
+		static I seti(std::uint32_t v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+		static I iota() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+
+		static F add(F a, F b) { return _mm256_add_ps(a, b); }
+		static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+		static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+		static F div(F a, F b) { return _mm256_div_ps(a, b); }
+		static F neg(F a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.f)); }
+		static F floor(F a) { return _mm256_floor_ps(a); }
+		static I to_int(F a) { return _mm256_cvttps_epi32(a); }
+		static F to_float(I a) { return _mm256_cvtepi32_ps(a); }
+
+		static I addi(I a, I b) { return _mm256_add_epi32(a, b); }
+		static I muli(I a, I b) { return _mm256_mullo_epi32(a, b); }
+		static I xori(I a, I b) { return _mm256_xor_si256(a, b); }
+		static I andi(I a, I b) { return _mm256_and_si256(a, b); }
+		template <int N> static I shr(I a) { return _mm256_srli_epi32(a, N); }
+
+		static M test(I h, std::uint32_t bit) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(h, seti(bit)), seti(bit))); }
+		static M lt(I h, std::uint32_t c) { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(seti(c), h)); }
+		static M eq(I h, std::uint32_t c) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(h, seti(c))); }
+		static M or_mask(M a, M b) { return _mm256_or_ps(a, b); }
+		static F select(M m, F if_true, F if_false) { return _mm256_blendv_ps(if_false, if_true, m); }
+
+		static void store(float* out, F v) { _mm256_storeu_ps(out, v); }
+		static void store_partial(float* out, int count, F v)
+		{
+			alignas(32) float lanes[LANES];
+			_mm256_store_ps(lanes, v);
+			for (int i = 0; i < count; i++) out[i] = lanes[i];
+		}
+	};
+
+	using AVX2Kernels = NoiseKernels::Kernels<AVX2Lanes>;
+}
+
+void NoiseKernels::fbm2_grid_avx2(std::int32_t x0, std::int32_t y0, int width, int height, float frequency,
+								   std::uint32_t seed, int octaves, float lacunarity, float gain, float* out)
+{
+	AVX2Kernels::fbm2_grid(x0, y0, width, height, frequency, seed, octaves, lacunarity, gain, out);
+}
+
+void NoiseKernels::fbm3_grid_avx2(std::int32_t x0, std::int32_t y0, std::int32_t z0, int width, int height, int depth,
+								   float frequency, std::uint32_t seed, int octaves, float lacunarity, float gain, float* out)
+{
+	AVX2Kernels::fbm3_grid(x0, y0, z0, width, height, depth, frequency, seed, octaves, lacunarity, gain, out);
+}
+
+#endif
@@ -0,0 +1,230 @@
+#pragma once
+
+// Noise kernels written once against a small lane abstraction V and instantiated for
+// plain floats, SSE4.1 and AVX2. Every backend performs the same IEEE operations in
+// the same order, so all of them give bit-identical results for a given seed.
+// Must be compiled without FMA contraction (see CMakeLists.txt).
+//
+// V provides: F (floats), I (uint32 lanes), M (lane mask), LANES, and
+// set(float), seti(uint32), iota(), add/sub/mul/div, floor, to_int, to_float,
+// addi, muli, xori, andi, shr<N>, test(I, bit), lt(I, c), eq(I, c), or_mask(M, M),
+// select(M, if_true, if_false), neg(F), store and store_partial.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace NoiseKernels
+{
+	template <typename V>
+	struct Kernels
+	{
+		using F = typename V::F;
+		using I = typename V::I;
+		using M = typename V::M;
+
+		static I hash(I x, I y, I z, I seed)
+		{
+			I h = seed;
+			h = V::xori(h, V::muli(x, V::seti(0x27d4eb2dU)));
+			h = V::xori(h, V::muli(y, V::seti(0x165667b1U)));
+			h = V::xori(h, V::muli(z, V::seti(0x9e3779b1U)));
+
+			// murmur3 finaliser
+			h = V::xori(h, V::template shr<16>(h));
+			h = V::muli(h, V::seti(0x85ebca6bU));
+			h = V::xori(h, V::template shr<13>(h));
+			h = V::muli(h, V::seti(0xc2b2ae35U));
+			h = V::xori(h, V::template shr<16>(h));
+			return h;
+		}
+
+		static F fade(F t)
+		{
+			// t * t * t * (t * (t * 6 - 15) + 10)
+			const F inner = V::add(V::mul(t, V::sub(V::mul(t, V::set(6.f)), V::set(15.f))), V::set(10.f));
+			return V::mul(V::mul(V::mul(t, t), t), inner);
+		}
+
+		static F lerp(F a, F b, F t) { return V::add(a, V::mul(t, V::sub(b, a))); }
+
+		static F negate_if(M mask, F v) { return V::select(mask, V::neg(v), v); }
+
+		// (+-1, +-2) and (+-2, +-1); the doubling is exact.
+		static F grad(I h, F x, F y)
+		{
+			const M swap = V::test(h, 4);
+			const F u = V::select(swap, y, x);
+			const F v = V::select(swap, x, y);
+			return V::add(negate_if(V::test(h, 1), u), negate_if(V::test(h, 2), V::add(v, v)));
+		}
+
+		// Perlin's improved noise gradients: the 12 cube edges, padded to 16.
+		static F grad(I h, F x, F y, F z)
+		{
+			const F u = V::select(V::lt(h, 8), x, y);
+			const F v = V::select(V::lt(h, 4), y, V::select(V::or_mask(V::eq(h, 12), V::eq(h, 14)), x, z));
+			return V::add(negate_if(V::test(h, 1), u), negate_if(V::test(h, 2), v));
+		}
+
+		static F perlin(F x, F y, I seed)
+		{
+			const F fx0 = V::floor(x), fy0 = V::floor(y);
+			const I x0 = V::to_int(fx0), y0 = V::to_int(fy0);
+			const I x1 = V::addi(x0, V::seti(1)), y1 = V::addi(y0, V::seti(1));
+			const I z0 = V::seti(0), mask = V::seti(15);
+			const F fx = V::sub(x, fx0), fy = V::sub(y, fy0);
+			const F fx1 = V::sub(fx, V::set(1.f)), fy1 = V::sub(fy, V::set(1.f));
+			const F u = fade(fx), v = fade(fy);
+
+			const F n00 = grad(V::andi(hash(x0, y0, z0, seed), mask), fx, fy);
+			const F n10 = grad(V::andi(hash(x1, y0, z0, seed), mask), fx1, fy);
+			const F n01 = grad(V::andi(hash(x0, y1, z0, seed), mask), fx, fy1);
+			const F n11 = grad(V::andi(hash(x1, y1, z0, seed), mask), fx1, fy1);
+
+			// Gradients have length sqrt(5), bring the result back to roughly -1..1.
+			return V::mul(lerp(lerp(n00, n10, u), lerp(n01, n11, u), v), V::set(0.5f));
+		}
+
+		static F perlin(F x, F y, F z, I seed)
+		{
+			const F fx0 = V::floor(x), fy0 = V::floor(y), fz0 = V::floor(z);
+			const I x0 = V::to_int(fx0), y0 = V::to_int(fy0), z0 = V::to_int(fz0);
+			const I one = V::seti(1), mask = V::seti(15);
+			const I x1 = V::addi(x0, one), y1 = V::addi(y0, one), z1 = V::addi(z0, one);
+			const F fx = V::sub(x, fx0), fy = V::sub(y, fy0), fz = V::sub(z, fz0);
+			const F fx1 = V::sub(fx, V::set(1.f)), fy1 = V::sub(fy, V::set(1.f)), fz1 = V::sub(fz, V::set(1.f));
+			const F u = fade(fx), v = fade(fy), w = fade(fz);
+
+			const F n000 = grad(V::andi(hash(x0, y0, z0, seed), mask), fx,  fy,  fz);
+			const F n100 = grad(V::andi(hash(x1, y0, z0, seed), mask), fx1, fy,  fz);
+			const F n010 = grad(V::andi(hash(x0, y1, z0, seed), mask), fx,  fy1, fz);
+			const F n110 = grad(V::andi(hash(x1, y1, z0, seed), mask), fx1, fy1, fz);
+			const F n001 = grad(V::andi(hash(x0, y0, z1, seed), mask), fx,  fy,  fz1);
+			const F n101 = grad(V::andi(hash(x1, y0, z1, seed), mask), fx1, fy,  fz1);
+			const F n011 = grad(V::andi(hash(x0, y1, z1, seed), mask), fx,  fy1, fz1);
+			const F n111 = grad(V::andi(hash(x1, y1, z1, seed), mask), fx1, fy1, fz1);
+
+			return lerp(lerp(lerp(n000, n100, u), lerp(n010, n110, u), v),
+						lerp(lerp(n001, n101, u), lerp(n011, n111, u), v), w);
+		}
+
+		static F fbm(F x, F y, std::uint32_t seed, int octaves, float lacunarity, float gain)
+		{
+			F sum = V::set(0.f);
+			float amplitude = 1.f, total = 0.f;
+			for (int i = 0; i < octaves; i++) {
+				sum = V::add(sum, V::mul(V::set(amplitude), perlin(x, y, V::seti(seed + static_cast<std::uint32_t>(i)))));
+				total += amplitude;
+				x = V::mul(x, V::set(lacunarity));
+				y = V::mul(y, V::set(lacunarity));
+				amplitude *= gain;
+			}
+			return total > 0.f ? V::div(sum, V::set(total)) : V::set(0.f);
+		}
+
+		static F fbm(F x, F y, F z, std::uint32_t seed, int octaves, float lacunarity, float gain)
+		{
+			F sum = V::set(0.f);
+			float amplitude = 1.f, total = 0.f;
+			for (int i = 0; i < octaves; i++) {
+				sum = V::add(sum, V::mul(V::set(amplitude), perlin(x, y, z, V::seti(seed + static_cast<std::uint32_t>(i)))));
+				total += amplitude;
+				x = V::mul(x, V::set(lacunarity));
+				y = V::mul(y, V::set(lacunarity));
+				z = V::mul(z, V::set(lacunarity));
+				amplitude *= gain;
+			}
+			return total > 0.f ? V::div(sum, V::set(total)) : V::set(0.f);
+		}
+
+		// Lattice coordinate (origin + i) * frequency for LANES consecutive i, matching the scalar conversion.
+		static F lattice(std::int32_t origin, int i, float frequency)
+		{
+			return V::mul(V::to_float(V::addi(V::seti(static_cast<std::uint32_t>(origin + i)), V::iota())), V::set(frequency));
+		}
+
+		static void fbm2_grid(std::int32_t x0, std::int32_t y0, int width, int height, float frequency,
+							  std::uint32_t seed, int octaves, float lacunarity, float gain, float* out)
+		{
+			for (int y = 0; y < height; y++) {
+				const F fy = V::mul(V::to_float(V::seti(static_cast<std::uint32_t>(y0 + y))), V::set(frequency));
+				float* row = out + static_cast<std::size_t>(width) * y;
+
+				int x = 0;
+				for (; x + V::LANES <= width; x += V::LANES)
+					V::store(row + x, fbm(lattice(x0, x, frequency), fy, seed, octaves, lacunarity, gain));
+				if (x < width)
+					V::store_partial(row + x, width - x, fbm(lattice(x0, x, frequency), fy, seed, octaves, lacunarity, gain));
+			}
+		}
+
+		static void fbm3_grid(std::int32_t x0, std::int32_t y0, std::int32_t z0, int width, int height, int depth,
+							  float frequency, std::uint32_t seed, int octaves, float lacunarity, float gain, float* out)
+		{
+			for (int z = 0; z < depth; z++) {
+				const F fz = V::mul(V::to_float(V::seti(static_cast<std::uint32_t>(z0 + z))), V::set(frequency));
+				for (int y = 0; y < height; y++) {
+					const F fy = V::mul(V::to_float(V::seti(static_cast<std::uint32_t>(y0 + y))), V::set(frequency));
+					float* row = out + static_cast<std::size_t>(width) * (y + static_cast<std::size_t>(height) * z);
+
+					int x = 0;
+					for (; x + V::LANES <= width; x += V::LANES)
+						V::store(row + x, fbm(lattice(x0, x, frequency), fy, fz, seed, octaves, lacunarity, gain));
+					if (x < width)
+						V::store_partial(row + x, width - x, fbm(lattice(x0, x, frequency), fy, fz, seed, octaves, lacunarity, gain));
+				}
+			}
+		}
+	};
+
+	// One float per lane; the reference the vector backends must match.
+	struct ScalarLanes
+	{
+		using F = float;
+		using I = std::uint32_t;
+		using M = bool;
+		static constexpr int LANES = 1;
+
+		static F set(float v) { return v; }
+		static I seti(std::uint32_t v) { return v; }
+		static I iota() { return 0; }
+
+		static F add(F a, F b) { return a + b; }
+		static F sub(F a, F b) { return a - b; }
+		static F mul(F a, F b) { return a * b; }
+		static F div(F a, F b) { return a / b; }
+		static F neg(F a) { return -a; }
+		static F floor(F a) { return std::floor(a); }
+		static I to_int(F a) { return static_cast<std::uint32_t>(static_cast<std::int32_t>(a)); }
+		static F to_float(I a) { return static_cast<float>(static_cast<std::int32_t>(a)); }
+
+		static I addi(I a, I b) { return a + b; }
+		static I muli(I a, I b) { return a * b; }
+		static I xori(I a, I b) { return a ^ b; }
+		static I andi(I a, I b) { return a & b; }
+		template <int N> static I shr(I a) { return a >> N; }
+
+		static M test(I h, std::uint32_t bit) { return (h & bit) != 0; }
+		static M lt(I h, std::uint32_t c) { return h < c; }
+		static M eq(I h, std::uint32_t c) { return h == c; }
+		static M or_mask(M a, M b) { return a || b; }
+		static F select(M m, F if_true, F if_false) { return m ? if_true : if_false; }
+
+		static void store(float* out, F v) { *out = v; }
+		static void store_partial(float* out, int, F v) { *out = v; }
+	};
+
+	using fbm2_grid_fn = void (*)(std::int32_t, std::int32_t, int, int, float, std::uint32_t, int, float, float, float*);
+	using fbm3_grid_fn = void (*)(std::int32_t, std::int32_t, std::int32_t, int, int, int, float, std::uint32_t, int, float, float, float*);
+
+	// Defined in NoiseSSE41.cpp and NoiseAVX2.cpp; only called when the CPU supports them.
+	void fbm2_grid_sse41(std::int32_t x0, std::int32_t y0, int width, int height, float frequency,
+						 std::uint32_t seed, int octaves, float lacunarity, float gain, float* out);
+	void fbm3_grid_sse41(std::int32_t x0, std::int32_t y0, std::int32_t z0, int width, int height, int depth,
+						 float frequency, std::uint32_t seed, int octaves, float lacunarity, float gain, float* out);
+	void fbm2_grid_avx2(std::int32_t x0, std::int32_t y0, int width, int height, float frequency,
+						std::uint32_t seed, int octaves, float lacunarity, float gain, float* out);
+	void fbm3_grid_avx2(std::int32_t x0, std::int32_t y0, std::int32_t z0, int width, int height, int depth,
+						float frequency, std::uint32_t seed, int octaves, float lacunarity, float gain, float* out);
+}
@@ -0,0 +1,65 @@
+#include <common/NoiseKernels.hpp>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <smmintrin.h>
+
+namespace
+{
+	struct SSE41Lanes
+	{
+		using F = __m128;
+		using I = __m128i;
+		using M = __m128;
+		static constexpr int LANES = 4;
+
+		static F set(float v) { return _mm_set1_ps(v); }
+		static I seti(std::uint32_t v) { return _mm_set1_epi32(static_cast<int>(v)); }
+		static I iota() { return _mm_setr_epi32(0, 1, 2, 3); }
+
+		static F add(F a, F b) { return _mm_add_ps(a, b); }
+		static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+		static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+		static F div(F a, F b) { return _mm_div_ps(a, b); }
+		static F neg(F a) { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+		static F floor(F a) { return _mm_floor_ps(a); }
+		static I to_int(F a) { return _mm_cvttps_epi32(a); }
+		static F to_float(I a) { return _mm_cvtepi32_ps(a); }
+
+		static I addi(I a, I b) { return _mm_add_epi32(a, b); }
+		static I muli(I a, I b) { return _mm_mullo_epi32(a, b); }
+		static I xori(I a, I b) { return _mm_xor_si128(a, b); }
+		static I andi(I a, I b) { return _mm_and_si128(a, b); }
+		template <int N> static I shr(I a) { return _mm_srli_epi32(a, N); }
+
+		static M test(I h, std::uint32_t bit) { return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(h, seti(bit)), seti(bit))); }
+		static M lt(I h, std::uint32_t c) { return _mm_castsi128_ps(_mm_cmplt_epi32(h, seti(c))); }
+		static M eq(I h, std::uint32_t c) { return _mm_castsi128_ps(_mm_cmpeq_epi32(h, seti(c))); }
+		static M or_mask(M a, M b) { return _mm_or_ps(a, b); }
+		static F select(M m, F if_true, F if_false) { return _mm_blendv_ps(if_false, if_true, m); }
+
+		static void store(float* out, F v) { _mm_storeu_ps(out, v); }
+		static void store_partial(float* out, int count, F v)
+		{
+			alignas(16) float lanes[LANES];
+			_mm_store_ps(lanes, v);
+			for (int i = 0; i < count; i++) out[i] = lanes[i];
+		}
+	};
+
+	using SSE41Kernels = NoiseKernels::Kernels<SSE41Lanes>;
+}
+
+void NoiseKernels::fbm2_grid_sse41(std::int32_t x0, std::int32_t y0, int width, int height, float frequency,
+								   std::uint32_t seed, int octaves, float lacunarity, float gain, float* out)
+{
+	SSE41Kernels::fbm2_grid(x0, y0, width, height, frequency, seed, octaves, lacunarity, gain, out);
+}
+
+void NoiseKernels::fbm3_grid_sse41(std::int32_t x0, std::int32_t y0, std::int32_t z0, int width, int height, int depth,
+								   float frequency, std::uint32_t seed, int octaves, float lacunarity, float gain, float* out)
+{
+	SSE41Kernels::fbm3_grid(x0, y0, z0, width, height, depth, frequency, seed, octaves, lacunarity, gain, out);
+}
+
+#endif
@@ -0,0 +1,97 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <memory>
+
+
+ThreadPool::ThreadPool(std::size_t thread_count)
+{
+	if (thread_count == 0)
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+	m_workers.reserve(thread_count);
+	for (std::size_t i = 0; i < thread_count; i++)
+		m_workers.emplace_back([this] { worker_loop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+
+	for (auto& worker : m_workers)
+		worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_tasks.push_back(std::move(task));
+	}
+	m_condition.notify_one();
+}
+
+void ThreadPool::parallel_for(std::size_t count, const std::function<void(std::size_t)>& fn)
+{
+	if (count == 0) return;
+
+	struct Batch
+	{
+		std::atomic<std::size_t> next{ 0 };
+		std::atomic<std::size_t> done{ 0 };
+		std::mutex mutex;
+		std::condition_variable finished;
+	};
+	auto batch = std::make_shared<Batch>();
+
+	// Workers and the caller pull indices from a shared counter, so uneven items balance out.
+	auto run = [batch, count, &fn] {
+		std::size_t processed = 0;
+		for (std::size_t i = batch->next++; i < count; i = batch->next++) {
+			fn(i);
+			processed++;
+		}
+
+		if (processed != 0 && batch->done.fetch_add(processed) + processed == count) {
+			std::lock_guard lock(batch->mutex);
+			batch->finished.notify_all();
+		}
+	};
+
+	const std::size_t helpers = std::min(m_workers.size(), count - 1);
+	for (std::size_t i = 0; i < helpers; i++)
+		submit(run);
+
+	run();
+
+	std::unique_lock lock(batch->mutex);
+	batch->finished.wait(lock, [&] { return batch->done.load() == count; });
+}
+
+ThreadPool& ThreadPool::get()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+void ThreadPool::worker_loop()
+{
+	for (;;) {
+		std::function<void()> task;
+		{
+			std::unique_lock lock(m_mutex);
+			m_condition.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+
+			if (m_stopping && m_tasks.empty())
+				return;
+
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	// 0 means one worker per hardware thread.
+	explicit ThreadPool(std::size_t thread_count = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void submit(std::function<void()> task);
+
+	// Runs fn(0..count-1) across the workers and the calling thread, returns when all are done.
+	// Must not be called from inside a pool task.
+	void parallel_for(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+	std::size_t get_thread_count() const { return m_workers.size(); }
+
+	// Engine-wide pool sized to the hardware.
+	static ThreadPool& get();
+
+private:
+	void worker_loop();
+
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stopping = false;
+};
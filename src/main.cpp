@@ -14,6 +14,7 @@
 
 #include <Resources/ResourceManager.hpp>
 
+#include <OpenGL/GLState.hpp>
 #include <OpenGL/ShaderProgram.hpp>
 #include <OpenGL/VertexBuffer.hpp>
 #include <OpenGL/VertexArray.hpp>
@@ -23,19 +24,45 @@
 
 
 #include <Render/Camera.hpp>
+#include <Render/FrameUniforms.hpp>
 
 #include <Voxel/Chunk.hpp>
 #include <Render/VoxelMesher.hpp>
+#include <Render/QuadIndexBuffer.hpp>
 #include <Object/Mesh.hpp>
 
 #include <Voxel/World.hpp>
+#include <Voxel/ChunkStreamer.hpp>
+#include <Voxel/NoiseTerrainGenerator.hpp>
 
 #include <glm/gtc/quaternion.hpp>
+#include <imgui.h>
 
 
 using namespace JPH::literals;
 
 
+static std::shared_ptr<World> create_world()
+{
+    std::shared_ptr<const TerrainGenerator> generator;
+    if (ImGuiWrapper::terrain_generator == 0)
+        generator = std::make_shared<SphereTerrainGenerator>();
+    else
+        generator = std::make_shared<NoiseTerrainGenerator>();
+
+    return std::make_shared<World>("debug_texture", std::move(generator), static_cast<std::uint32_t>(ImGuiWrapper::world_seed),
+                                   static_cast<VoxelMesher::EMode>(ImGuiWrapper::mesher_mode));
+}
+
+static ChunkStreamer::Settings streamer_settings()
+{
+    ChunkStreamer::Settings settings;
+    settings.render_radius = ImGuiWrapper::view_distance;
+    settings.cache_capacity = static_cast<std::size_t>(ImGuiWrapper::chunk_cache_size);
+    return settings;
+}
+
+
 int main(const int argc, const char** argv) try
 {
     ResourceManager::init(argv[0]);
@@ -66,20 +93,21 @@ int main(const int argc, const char** argv) try
     glEnable(GL_DEPTH_TEST);
 
     Camera camera(window.get_aspect());
-    camera.set_position({ 8.f, 8.f, 24.f });
+    camera.set_position({ 8.f, 64.f, 24.f });
 
 
     ResourceManager::load_texture("debug_texture", "res/Textures/block.png");
     auto shared = ResourceManager::load_shader_program("voxel_shared", "res/Shaders/main.glslv", "res/Shaders/main.glslf");
+    FrameUniforms frame_uniforms;
 
-    glm::ivec3 world_size = ImGuiWrapper::world_size;
-    
+    int mesher_mode = ImGuiWrapper::mesher_mode;
+    int terrain_generator = ImGuiWrapper::terrain_generator;
+    int world_seed = ImGuiWrapper::world_seed;
+    int view_distance = ImGuiWrapper::view_distance;
+    int chunk_cache_size = ImGuiWrapper::chunk_cache_size;
 
-    const auto start{ std::chrono::steady_clock::now() };
-    std::shared_ptr<World> w = std::make_shared<World>(world_size.x, world_size.y, world_size.z, "debug_texture");
-    const auto finish{ std::chrono::steady_clock::now() };
-    const std::chrono::duration<double> elapsed_seconds{ finish - start };
-    LOG_INFO("World has been created for {}s", elapsed_seconds.count());
+    auto w = create_world();
+    auto streamer = std::make_unique<ChunkStreamer>(*w, streamer_settings());
 
 
     //glfw::swapInterval(1);
@@ -90,14 +118,21 @@ int main(const int argc, const char** argv) try
         if (Input::IsKeyPressed(KeyCode::KEY_ESCAPE)) glfwSetWindowShouldClose(window.get_window(), GLFW_TRUE);
 
 
-        if (world_size != ImGuiWrapper::world_size)
+        if (mesher_mode != ImGuiWrapper::mesher_mode || terrain_generator != ImGuiWrapper::terrain_generator ||
+            world_seed != ImGuiWrapper::world_seed)
         {
-            world_size = ImGuiWrapper::world_size;
-            const auto start{ std::chrono::steady_clock::now() };
-            w = std::make_shared<World>(world_size.x, world_size.y, world_size.z, "debug_texture");
-            const auto finish{ std::chrono::steady_clock::now() };
-            const std::chrono::duration<double> elapsed_seconds{ finish - start };
-            LOG_INFO("World has been created for {}s", elapsed_seconds.count());
+            mesher_mode = ImGuiWrapper::mesher_mode;
+            terrain_generator = ImGuiWrapper::terrain_generator;
+            world_seed = ImGuiWrapper::world_seed;
+            streamer.reset();
+            w = create_world();
+            streamer = std::make_unique<ChunkStreamer>(*w, streamer_settings());
+        }
+        else if (view_distance != ImGuiWrapper::view_distance || chunk_cache_size != ImGuiWrapper::chunk_cache_size)
+        {
+            view_distance = ImGuiWrapper::view_distance;
+            chunk_cache_size = ImGuiWrapper::chunk_cache_size;
+            streamer->set_settings(streamer_settings());
         }
 
 
@@ -136,6 +171,7 @@ int main(const int argc, const char** argv) try
 
 
         /* Render here */
+        GLState::invalidate(); // ImGui's backend binds GL objects directly
         glClearColor(ImGuiWrapper::clear_color[0], ImGuiWrapper::clear_color[1], ImGuiWrapper::clear_color[2], 1);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -147,7 +183,56 @@ int main(const int argc, const char** argv) try
         //mesh.draw(shared, camera);
         shared->bind();
 
+        w->set_lod_distance(ImGuiWrapper::lod_distance);
+        w->update_lods(camera.get_position(), 64);
+        streamer->update(camera.get_position(), camera.get_direction());
+        w->remesh_dirty_chunks();
+        w->upload_meshes(static_cast<std::size_t>(ImGuiWrapper::mesh_upload_budget) * 1024);
+        frame_uniforms.update(camera, static_cast<float>(currentTime));
         w->draw(shared, camera);
+        ImGuiWrapper::chunks_drawn = w->get_draw_stats().chunks_drawn;
+        ImGuiWrapper::chunks_culled = w->get_draw_stats().chunks_culled;
+        ImGuiWrapper::chunks_empty = w->get_draw_stats().chunks_empty;
+        for (int lod = 0; lod < CHUNK_LOD_COUNT; lod++)
+            ImGuiWrapper::chunks_per_lod[lod] = w->get_draw_stats().chunks_per_lod[lod];
+        ImGuiWrapper::draw_batches = w->get_draw_stats().batches;
+        ImGuiWrapper::draw_calls = w->get_draw_stats().draw_calls;
+        ImGuiWrapper::vertices_drawn = w->get_draw_stats().vertices_drawn;
+        ImGuiWrapper::vertices_skipped = w->get_draw_stats().vertices_skipped;
+        const auto gl_stats = GLState::take_stats();
+        ImGuiWrapper::gl_binds = gl_stats.binds;
+        ImGuiWrapper::gl_skipped = gl_stats.skipped;
+
+        const auto& stream_stats = streamer->get_stats();
+        ImGuiWrapper::chunks_loaded = stream_stats.loaded;
+        ImGuiWrapper::chunks_cached = stream_stats.cached;
+        ImGuiWrapper::chunks_pending = stream_stats.pending_generate + stream_stats.pending_mesh;
+        ImGuiWrapper::meshes_in_flight = w->get_build_stats().builds_in_flight;
+        ImGuiWrapper::meshes_uploaded = w->get_build_stats().uploaded;
+        ImGuiWrapper::generate_ms = stream_stats.generate_seconds * 1000.0;
+        ImGuiWrapper::mesh_ms = w->get_build_stats().mesh_seconds * 1000.0;
+        ImGuiWrapper::upload_ms = w->get_build_stats().upload_seconds * 1000.0;
+        ImGuiWrapper::mesh_threads = w->get_build_stats().thread_count;
+        const auto arena_stats = w->get_mesh_arena_stats();
+        ImGuiWrapper::mesh_arena_pages = arena_stats.pages;
+        ImGuiWrapper::mesh_arena_used = arena_stats.used * sizeof(ChunkVertex);
+        ImGuiWrapper::mesh_arena_capacity = arena_stats.capacity * sizeof(ChunkVertex);
+        ImGuiWrapper::mesh_arena_fragmentation = arena_stats.fragmentation;
+        ImGuiWrapper::stream_buffer_used = w->get_stream_stats().used;
+        ImGuiWrapper::stream_buffer_missed = w->get_stream_stats().missed;
+        ImGuiWrapper::stream_buffer_waits = w->get_stream_stats().waits;
+        ImGuiWrapper::world_vertex_count = w->get_vertex_count();
+        ImGuiWrapper::world_vertex_memory = w->get_vertex_count() * sizeof(ChunkVertex);
+        ImGuiWrapper::world_chunk_memory = w->get_chunk_memory_usage();
+
+        // Left click removes the voxel under the crosshair; the chunk is remeshed in the background.
+        static bool was_dig_pressed = false;
+        const bool dig_pressed = Input::IsMouseButtonPressed(MouseButton::MOUSE_BUTTON_1) && !ImGui::GetIO().WantCaptureMouse;
+        if (dig_pressed && !was_dig_pressed) {
+            if (auto hit = w->raycast(camera.get_position(), camera.get_direction(), 64.f))
+                w->set_voxel(*hit, 0);
+        }
+        was_dig_pressed = dig_pressed;
 
         if (Input::IsMouseButtonPressed(MouseButton::MOUSE_BUTTON_2)) {
             camera.set_rotate_delta(Input::get_mouse_delta(), deltaTime);
@@ -168,6 +253,7 @@ int main(const int argc, const char** argv) try
     }
 
     ResourceManager::destroy();
+    QuadIndexBuffer::destroy();
     ImGuiWrapper::destroy_imgui_context();
     return 0;
 }